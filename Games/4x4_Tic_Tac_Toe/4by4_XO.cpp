@@ -1,74 +1,159 @@
 #include "4by4_XO.h"
+#include "../../header/Random.h"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iomanip>
 #include <cmath>
+#include <chrono>
 
 using namespace std;
 
+uint16_t _4by4XO_Board::neighbours[16] {};
+
+// The 24 three-in-a-row lines of the 4x4 board as 16-bit masks
+static uint16_t LINES[24];
+
+// Zobrist keys: one per side and cell, one for O to move
+static uint64_t zobrist[2][16];
+static uint64_t zobrist_side;
+
 _4by4XO_Board::_4by4XO_Board() : Board<char>(4, 4) {
     n_moves = 0;
-    
+
+    if (neighbours[0] == 0) {
+        for (int c = 0; c < 16; ++c) {
+            int r = c / 4, col = c % 4;
+            if (r > 0) neighbours[c] |= 1 << (c - 4);
+            if (r < 3) neighbours[c] |= 1 << (c + 4);
+            if (col > 0) neighbours[c] |= 1 << (c - 1);
+            if (col < 3) neighbours[c] |= 1 << (c + 1);
+        }
+
+        // Each direction: step between cells, and the rows and columns a line may start from
+        static const int DIRS[4][5] = {{1, 0, 3, 0, 1}, {4, 0, 1, 0, 3}, {5, 0, 1, 0, 1}, {3, 0, 1, 2, 3}};
+        int n = 0;
+        for (auto& d : DIRS)
+            for (int r = d[1]; r <= d[2]; ++r)
+                for (int col = d[3]; col <= d[4]; ++col) {
+                    int start = 4 * r + col;
+                    LINES[n++] = (1 << start) | (1 << (start + d[0])) | (1 << (start + 2 * d[0]));
+                }
+
+        Random rng(0x4B1D4B1D4B1D4B1DULL);
+        for (auto& side : zobrist)
+            for (auto& key : side) key = rng.next();
+        zobrist_side = rng.next();
+    }
+
     board[0][0] = 'X'; board[0][1] = 'O'; board[0][2] = 'X'; board[0][3] = 'O';
-    
+
     board[3][0] = 'O'; board[3][1] = 'X'; board[3][2] = 'O'; board[3][3] = 'X';
+
+    for (int c = 0; c < 16; ++c) {
+        char s = board[c / 4][c % 4];
+        if (s == 0) continue;
+        int side = (s == 'X') ? 0 : 1;
+        bits[side] |= 1 << c;
+        hash ^= zobrist[side][c];
+    }
+    hashes.push_back(hash);
+}
+
+bool _4by4XO_Board::has_three(uint16_t b) {
+    // Starting cells of a horizontal, vertical, diagonal and anti-diagonal line
+    return (b & b >> 1 & b >> 2 & 0x3333) || (b & b >> 4 & b >> 8 & 0x00FF) ||
+           (b & b >> 5 & b >> 10 & 0x0033) || (b & b >> 3 & b >> 6 & 0x00CC);
+}
+
+int _4by4XO_Board::legal_moves(int side, int* moves) const {
+    uint16_t empty = ~(bits[0] | bits[1]);
+    int count = 0;
+
+    for (uint16_t tokens = bits[side]; tokens; tokens &= tokens - 1) {
+        int from = __builtin_ctz(tokens);
+        for (uint16_t to = neighbours[from] & empty; to; to &= to - 1)
+            moves[count++] = 16 * from + __builtin_ctz(to);
+    }
+    return count;
+}
+
+void _4by4XO_Board::play(int move) {
+    int from = move >> 4, to = move & 15;
+    int side = (bits[0] >> from & 1) ? 0 : 1;
+
+    bits[side] ^= (1 << from) | (1 << to);
+    hash ^= zobrist[side][from] ^ zobrist[side][to] ^ zobrist_side;
+
+    board[to / 4][to % 4] = board[from / 4][from % 4];
+    board[from / 4][from % 4] = 0;
+    n_moves++;
+
+    history.push_back(move);
+    hashes.push_back(hash);
+}
+
+void _4by4XO_Board::undo() {
+    int move = history.back();
+    history.pop_back();
+    hashes.pop_back();
+
+    int from = move >> 4, to = move & 15;
+    int side = (bits[0] >> to & 1) ? 0 : 1;
+
+    bits[side] ^= (1 << from) | (1 << to);
+    hash ^= zobrist[side][from] ^ zobrist[side][to] ^ zobrist_side;
+
+    board[from / 4][from % 4] = board[to / 4][to % 4];
+    board[to / 4][to % 4] = 0;
+    n_moves--;
+}
+
+int _4by4XO_Board::repetitions() const {
+    // Only positions with the same side to move can match
+    int count = 0;
+    for (int i = int(hashes.size()) - 1; i >= 0; i -= 2)
+        if (hashes[i] == hash) count++;
+    return count;
 }
 
 bool _4by4XO_Board::update_board(Move<char>* move) {
+    char s = move->get_symbol();
+
+    if (s == 0) { // Undo the last move
+        if (!history.empty()) undo();
+        return true;
+    }
+
     _4by4XO_Move* m = static_cast<_4by4XO_Move*>(move);
 
     int fx = m->get_from_x();
     int fy = m->get_from_y();
     int tx = m->get_x();
     int ty = m->get_y();
-    char s = m->get_symbol();
 
-    
+
     if (fx < 0 || fx >= 4 || fy < 0 || fy >= 4 || tx < 0 || tx >= 4 || ty < 0 || ty >= 4) return false;
 
-    
+
     if (board[fx][fy] != s) return false;
 
-    
+    // The hash tracks the side to move, so players must alternate
+    if ((s == 'X' ? 0 : 1) != side_to_move()) return false;
+
+
     if (board[tx][ty] != 0) return false;
 
-    
+
     if (abs(fx - tx) + abs(fy - ty) != 1) return false;
 
-    
-    board[tx][ty] = s;
-    board[fx][fy] = 0;
-    n_moves++;
+
+    play(16 * (4 * fx + fy) + 4 * tx + ty);
     return true;
 }
 
 bool _4by4XO_Board::is_win(Player<char>* player) {
-    char s = player->get_symbol();
-    
-    for (int i = 0; i < 4; i++) {
-        
-        if (board[i][0] == s && board[i][1] == s && board[i][2] == s) return true;
-        if (board[i][1] == s && board[i][2] == s && board[i][3] == s) return true;
-        
-        
-        if (board[0][i] == s && board[1][i] == s && board[2][i] == s) return true;
-        if (board[1][i] == s && board[2][i] == s && board[3][i] == s) return true;
-    }
-    
-   
-    if (board[0][0] == s && board[1][1] == s && board[2][2] == s) return true;
-    if (board[1][1] == s && board[2][2] == s && board[3][3] == s) return true;
-    if (board[0][1] == s && board[1][2] == s && board[2][3] == s) return true;
-    if (board[1][0] == s && board[2][1] == s && board[3][2] == s) return true;
-
-    
-    if (board[0][3] == s && board[1][2] == s && board[2][1] == s) return true;
-    if (board[1][2] == s && board[2][1] == s && board[3][0] == s) return true;
-    if (board[0][2] == s && board[1][1] == s && board[2][0] == s) return true;
-    if (board[1][3] == s && board[2][2] == s && board[3][1] == s) return true;
-
-    return false;
+    return has_three(bits[player->get_symbol() == 'X' ? 0 : 1]);
 }
 
 bool _4by4XO_Board::is_lose(Player<char>* player) {
@@ -76,7 +161,9 @@ bool _4by4XO_Board::is_lose(Player<char>* player) {
 }
 
 bool _4by4XO_Board::is_draw(Player<char>* player) {
-    return n_moves > 100; // Safety limit
+    if (is_win(player)) return false;
+    int moves[16];
+    return repetitions() >= 3 || n_moves > MOVE_LIMIT || legal_moves(side_to_move(), moves) == 0;
 }
 
 bool _4by4XO_Board::game_is_over(Player<char>* player) {
@@ -92,9 +179,152 @@ Player<char>* _4by4XO_UI::create_player(string& name, char symbol, PlayerType ty
 Move<char>* _4by4XO_UI::get_move(Player<char>* player) {
     int fx, fy, tx, ty;
     cout << player->get_name() << " (" << player->get_symbol() << ")\n";
+
+    if (player->get_type() == PlayerType::COMPUTER) {
+        auto* b = static_cast<_4by4XO_Board*>(player->get_board_ptr());
+        int move = engine.best_move(b, timeLimitMs);
+        if (move < 0) move = 0;   // Never asked: a side without a move has drawn already
+        fx = (move >> 4) / 4, fy = (move >> 4) % 4;
+        tx = (move & 15) / 4, ty = (move & 15) % 4;
+        cout << "Moves (" << fx << ", " << fy << ") to (" << tx << ", " << ty << ")\n";
+        return new _4by4XO_Move(fx, fy, tx, ty, player->get_symbol());
+    }
+
     cout << "Select token to move (row col): ";
     cin >> fx >> fy;
     cout << "Select destination (row col): ";
     cin >> tx >> ty;
     return new _4by4XO_Move(fx, fy, tx, ty, player->get_symbol());
 }
+
+//=====================AI===========
+
+_4by4XO_Engine::_4by4XO_Engine(int tableBits)
+    : table(size_t(1) << tableBits), tableMask((uint64_t(1) << tableBits) - 1)
+{
+}
+
+int _4by4XO_Engine::best_move(_4by4XO_Board* board, int timeLimitMs, int maxDepth)
+{
+    this->board = board;
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(timeLimitMs);
+    nodes = 0;
+    stopped = false;
+
+    int side = board->side_to_move();
+    int moves[16];
+    int count = board->legal_moves(side, moves);
+    if (count == 0) return -1;
+
+    // A winning slide needs no search
+    for (int i = 0; i < count; ++i)
+        if (_4by4XO_Board::has_three(board->get_bits(side) ^ (1 << (moves[i] >> 4)) ^ (1 << (moves[i] & 15))))
+            return moves[i];
+
+    int best = moves[0];
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        int value = negamax(depth, 0, -WIN, WIN);
+        if (stopped) break;   // An unfinished iteration is not trusted
+
+        const Entry& e = table[board->get_hash() & tableMask];
+        if (e.key == board->get_hash())
+            for (int i = 0; i < count; ++i)
+                if (moves[i] == e.move) best = e.move;
+
+        // Nothing left to decide when the only move is forced or the result is known
+        if (count == 1 || abs(value) > WIN / 2) break;
+    }
+    return best;
+}
+
+int _4by4XO_Engine::negamax(int depth, int ply, int alpha, int beta)
+{
+    int side = board->side_to_move();
+    uint16_t mine = board->get_bits(side);
+
+    // The previous move may have ended the game
+    if (_4by4XO_Board::has_three(board->get_bits(1 - side)))
+        return -(WIN - board->get_moves());
+    if (ply > 0 && board->repetitions() >= 2) return 0;
+    if (board->get_moves() > _4by4XO_Board::MOVE_LIMIT) return 0;
+
+    int moves[16];
+    int count = board->legal_moves(side, moves);
+    if (count == 0) return 0;
+
+    for (int i = 0; i < count; ++i)
+        if (_4by4XO_Board::has_three(mine ^ (1 << (moves[i] >> 4)) ^ (1 << (moves[i] & 15))))
+            return WIN - (board->get_moves() + 1);
+
+    if (depth == 0) return evaluate();
+
+    if ((++nodes & 4095) == 0 && chrono::steady_clock::now() >= deadline) stopped = true;
+    if (stopped) return 0;
+
+    uint64_t key = board->get_hash();
+    Entry& slot = table[key & tableMask];
+    int ttMove = -1;
+
+    if (slot.key == key) {
+        ttMove = slot.move;
+        if (slot.depth >= depth) {
+            if (slot.bound == EXACT) return slot.value;
+            if (slot.bound == LOWER && slot.value >= beta) return slot.value;
+            if (slot.bound == UPPER && slot.value <= alpha) return slot.value;
+        }
+    }
+
+    // Try the table's move first
+    for (int i = 1; i < count; ++i)
+        if (moves[i] == ttMove) {
+            moves[i] = moves[0];
+            moves[0] = ttMove;
+        }
+
+    int origAlpha = alpha;
+    int best = -WIN, bestMove = moves[0];
+
+    for (int i = 0; i < count; ++i) {
+        board->play(moves[i]);
+        int val = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        board->undo();
+        if (stopped) return 0;
+
+        if (val > best) {
+            best = val;
+            bestMove = moves[i];
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    slot.key = key;
+    slot.value = (int16_t)best;
+    slot.depth = (uint8_t)depth;
+    slot.move = (int16_t)bestMove;
+    slot.bound = best <= origAlpha ? UPPER : (best >= beta ? LOWER : EXACT);
+
+    return best;
+}
+
+int _4by4XO_Engine::evaluate() const
+{
+    int side = board->side_to_move();
+    int score = 0;
+
+    for (int s : {side, 1 - side}) {
+        uint16_t mine = board->get_bits(s), theirs = board->get_bits(1 - s);
+        int sign = (s == side) ? 1 : -1;
+
+        // Open twos, and more for those a token off the line can complete next move
+        for (uint16_t line : LINES) {
+            if ((line & theirs) || __builtin_popcount(line & mine) != 2) continue;
+            int gap = __builtin_ctz(line & ~mine);
+            score += sign * ((_4by4XO_Board::neighbours[gap] & mine & ~line) ? 40 : 10);
+        }
+
+        int moves[16];
+        score += sign * board->legal_moves(s, moves);
+    }
+    return score;
+}
@@ -1,19 +1,44 @@
 #pragma once
 
 #include "../../header/BoardGame_Classes.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
 
 class _4by4XO_Move : public Move<char> {
     int from_x, from_y;
 public:
-    _4by4XO_Move(int fx, int fy, int tx, int ty, char s) 
+    _4by4XO_Move(int fx, int fy, int tx, int ty, char s)
         : Move<char>(tx, ty, s), from_x(fx), from_y(fy) {}
     int get_from_x() const { return from_x; }
     int get_from_y() const { return from_y; }
 };
 
+/**
+ * @brief 4x4 sliding Tic-Tac-Toe backed by one 16-bit bitboard per side.
+ *
+ * Cell (r, c) is bit 4 * r + c. A move slides one of the mover's tokens to
+ * an orthogonally adjacent empty cell and is addressed as 16 * from + to;
+ * the legal destinations of a token are its neighbour mask minus the
+ * occupied cells. Three in a row is found with shifts of the whole board.
+ *
+ * Tokens only move, so positions recur: the board keeps a Zobrist hash and
+ * the hash after every move, and a position that occurs for the third time
+ * (same tokens, same side to move) is a draw, as is a game that runs past
+ * MOVE_LIMIT moves or a side left without a move.
+ */
 class _4by4XO_Board : public Board<char>
 {
+private:
+    uint16_t bits[2] {};                    ///< Tokens of X ([0]) and O ([1]).
+    uint64_t hash = 0;                      ///< Zobrist hash of the tokens and the side to move.
+    std::vector<int> history;               ///< Moves played (16 * from + to), for undo.
+    std::vector<uint64_t> hashes;           ///< Hash of every position of the game, the current one last.
+
 public:
+    static uint16_t neighbours[16];         ///< Cells orthogonally adjacent to each cell.
+    static const int MOVE_LIMIT = 100;      ///< The game is drawn after this many moves.
+
     _4by4XO_Board();
 
     bool update_board(Move<char>* move) override;
@@ -25,15 +50,114 @@ public:
     bool is_draw(Player<char>* player) override;
 
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Write every legal move (16 * from + to) of a side.
+     * @param side 0 for X, 1 for O.
+     * @param moves Output array with room for 16 moves.
+     * @return The number of moves written.
+     */
+    int legal_moves(int side, int* moves) const;
+
+    /** @brief Slide the token on a move's from cell to its to cell (must be legal). */
+    void play(int move);
+
+    /** @brief Take back the last move played. */
+    void undo();
+
+    /** @brief Tokens of a side (0 for X, 1 for O). */
+    uint16_t get_bits(int side) const { return bits[side]; }
+
+    /** @brief Zobrist hash of the position, including the side to move. */
+    uint64_t get_hash() const { return hash; }
+
+    /** @brief Number of moves played. */
+    int get_moves() const { return n_moves; }
+
+    /** @brief Side to move: 0 for X, 1 for O. */
+    int side_to_move() const { return n_moves & 1; }
+
+    /** @brief Times the current position has occurred, this time included. */
+    int repetitions() const;
+
+    /** @brief True if a bitboard holds three in a row. */
+    static bool has_three(uint16_t b);
+};
+
+
+/**
+ * @brief Alpha-beta search engine for 4x4 sliding Tic-Tac-Toe.
+ *
+ * Negamax with a transposition table keyed by the board's Zobrist hash and
+ * iterative deepening under a time budget. A position seen before on the
+ * game or search path scores as a draw, since the side that prefers a draw
+ * can repeat it. Leaves are scored by open twos, counting more those whose
+ * gap a token of the same side can slide into next move.
+ */
+class _4by4XO_Engine {
+public:
+    /**
+     * @brief Construct the engine and allocate its transposition table.
+     * @param tableBits log2 of the number of transposition table entries.
+     */
+    explicit _4by4XO_Engine(int tableBits = 20);
+
+    /**
+     * @brief Search the board until the time budget runs out (the board is restored).
+     * @param board The live game board.
+     * @param timeLimitMs Time budget in milliseconds.
+     * @param maxDepth Upper bound on the iterative deepening depth.
+     * @return The best move as 16 * from + to, -1 if the side to move is stuck.
+     */
+    int best_move(_4by4XO_Board* board, int timeLimitMs, int maxDepth = 40);
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = 0;       ///< Zobrist hash, 0 when empty.
+        int16_t value = 0;      ///< Stored score.
+        uint8_t depth = 0;      ///< Depth the score was searched to.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+        int16_t move = -1;      ///< Best move found in this position.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @brief Negamax alpha-beta search.
+     * @param ply Moves made since the root.
+     * @return Score for the side to move; WIN - moves for a won game.
+     */
+    int negamax(int depth, int ply, int alpha, int beta);
+
+    /**
+     * @brief Static evaluation from open twos and threats.
+     * @return Score for the side to move.
+     */
+    int evaluate() const;
+
+    static const int WIN = 10000;               ///< Base score of a win (minus the moves played).
+
+    _4by4XO_Board* board = nullptr;             ///< Board being searched.
+    std::vector<Entry> table;                   ///< Transposition table (power of two size).
+    uint64_t tableMask;                         ///< Index mask for the table.
+    std::chrono::steady_clock::time_point deadline;   ///< Time at which the search stops.
+    long long nodes = 0;                        ///< Nodes visited in the current search.
+    bool stopped = false;                       ///< True once the time budget ran out.
 };
 
 
 class _4by4XO_UI : public UI<char>
 {
+private:
+    _4by4XO_Engine engine;      ///< Search engine used by the computer player.
+    int timeLimitMs = 1000;     ///< Thinking time per computer move.
 public:
     _4by4XO_UI();
-    
+
     Player<char>* create_player(std::string& name, char symbol, PlayerType type) override;
 
     Move<char>* get_move(Player<char>* player) override;
-};
\ No newline at end of file
+};
@@ -2,7 +2,6 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype> // for toupper()
-#include <climits> //for INT_MAX INT_MIN
 #include "four.h"
 
 using namespace std;
@@ -18,67 +17,62 @@ FOUR_Board::FOUR_Board() : Board(6, 7)
 }
 
 bool FOUR_Board::update_board(Move<char> *move)
-{   int y = move->get_y();
-    int x = 5-last_row[y]++;
-   //5 - last_row[y] gives the index of the lowest available row in this column
- 
+{
+    int y = move->get_y();
     char mark = move->get_symbol();
 
-    // Validate move and apply if valid
-    if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0))
-    {
-
-        if (mark == 0)
-        { // Undo move
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else
-        { // Apply move
-            n_moves++;
-            board[x][y] = toupper(mark);
-        }
+    if (mark == 0)
+    { // Undo move: take back the top stone of the column
+        if (y < 0 || y >= columns || heights[y] == 0)
+            return false;
+        undo(y);
         return true;
     }
-    return false;
+
+    // Validate move and apply if valid (the column decides the row)
+    if (!can_play(y))
+        return false;
+
+    drop(y, toupper(mark));
+    return true;
 }
 
-bool FOUR_Board::is_win(Player<char> *player)
+void FOUR_Board::drop(int col, char mark)
 {
+    // Row 0 of the matrix is the top, so height h lands on row 5 - h
+    board[HEIGHT - 1 - heights[col]][col] = mark;
+    (mark == 'X' ? bitsX : bitsO) |= cell_bit(col, heights[col]++);
+    n_moves++;
+}
 
-    const char sym = player->get_symbol();
+void FOUR_Board::undo(int col)
+{
+    uint64_t bit = cell_bit(col, --heights[col]);
+    bitsX &= ~bit;
+    bitsO &= ~bit;
+    board[HEIGHT - 1 - heights[col]][col] = blank_symbol;
+    n_moves--;
+}
 
-    auto all_equal = [&](char a, char b, char c,char d)
-    {
-        return a == b && b == c && c==d&& a != blank_symbol;
-    };
-
-    // Check rows and columns
- for (int i=0; i < rows; ++i) {
-    for (int j = 0; j < columns ; ++j) {  
-        if (j+3<7&&all_equal(board[i][j], board[i][j+1], board[i][j+2], board[i][j+3]))
-            return true;
-    }
+bool FOUR_Board::is_winning_move(int col, char mark) const
+{
+    return has_four(get_bits(mark) | cell_bit(col, heights[col]));
 }
-for (int i = 0; i <rows ; ++i) { 
-    for (int j = 0; j < columns; ++j) {
-        if (i+3<6&&all_equal(board[i][j], board[i+1][j], board[i+2][j], board[i+3][j]))
-            return true;
+
+bool FOUR_Board::has_four(uint64_t bits)
+{
+    // Vertical (1), horizontal (7) and the two diagonals (6, 8); the sentinel
+    // row keeps the shifts from wrapping between columns
+    for (int shift : {1, HEIGHT + 1, HEIGHT, HEIGHT + 2}) {
+        uint64_t pairs = bits & (bits >> shift);
+        if (pairs & (pairs >> (2 * shift))) return true;
     }
+    return false;
 }
-    // Check diagonals
-   for (int i=0; i<rows;++i){
-    for (int j=0; j<columns;++j){
-        if (i-3>=0&&j+3<7 &&all_equal(board[i][j], board[i-1][j+1], board[i-2][j+2],board[i-3][j+3]) && board[i][j] == sym)
-        return true;
-        if (i+3<6 && j+3<7 &&all_equal(board[i][j], board[i+1][j+1], board[i+2][j+2],board[i+3][j+3]) && board[i][j] == sym)
-         return true;
-    }
-   }
-      
 
-    return false;
+bool FOUR_Board::is_win(Player<char> *player)
+{
+    return has_four(get_bits(toupper(player->get_symbol())));
 }
 
 bool FOUR_Board::is_draw(Player<char> *player)
@@ -101,23 +95,15 @@ Player<char> *FOUR_UI::create_player(string &name, char symbol, PlayerType type)
 
 Move<char> *FOUR_UI::get_move(Player<char> *player)
 { 
-    int  y; int x;
+    int  y;
     if (player->get_type() == PlayerType::HUMAN)
     {
         cout << "\nPlease enter your column (0 to 6): ";
         cin >>  y;
     }
      else if (player->get_type() == PlayerType::COMPUTER) {
-        AI=player->get_symbol();
-        if (AI=='X'){
-             OOP='O';
-        }
-        else if (AI=='O'){
-             OOP='X';
-        }
-       auto* b = dynamic_cast<FOUR_Board*>(player->get_board_ptr());
-        y = FOUR_UI::findBestMove(b->get_board_matrix());
-        
+        auto* b = dynamic_cast<FOUR_Board*>(player->get_board_ptr());
+        y = engine.best_move(b, toupper(player->get_symbol()), searchDepth);
     }
     
     return new Move<char>(0, y, player->get_symbol());
@@ -125,138 +111,161 @@ Move<char> *FOUR_UI::get_move(Player<char> *player)
 
 //==================================AI Implementation===================
 
-bool FOUR_UI::isMovesLeft(vector<vector<char>>& board)
-{
-    for (int i = 0; i < 6; i++)
-        for (int j = 0; j < 7; j++)
-            if (board[i][j] == '.')
-                return true;
-    return false;
-}
+// Columns from the centre outwards: central stones take part in the most fours
+static const int COLUMN_ORDER[FOUR_Board::WIDTH] = {3, 2, 4, 1, 5, 0, 6};
 
+uint64_t FOUR_Engine::windows[69] {};
 
-int  FOUR_UI::evaluate(vector<vector<char>>& board)
+// One bit per playable cell in the lowest column, repeated for every column
+static const uint64_t BOTTOM_ROW = 0x40810204081ULL;
+
+const uint64_t FOUR_Engine::BOARD_MASK = BOTTOM_ROW * ((1ULL << FOUR_Board::HEIGHT) - 1);
+const uint64_t FOUR_Engine::ODD_ROWS = BOTTOM_ROW * 0x15;
+
+FOUR_Engine::FOUR_Engine(int tableBits)
+    : table(size_t(1) << tableBits), tableMask((uint64_t(1) << tableBits) - 1)
 {
-    //Check for a win in  rows, columns, and diagonals.
-    for (int i=0; i < 6; ++i) {
-      for (int j = 0; j < 4 ; ++j) {  
-        if (j+3<7&&(board[i][j] == board[i][j+1] && board[i][j+1] == board[i][j+2] && board[i][j+2] == board[i][j+3]&&board[i][j]!='.'))
-            if (board[i][j]==AI)
-                return +10;
-            else if (board[i][j]==OOP)
-                return -10;
-       }
-    }
-   
-    for (int i=0; i < 3; ++i) {
-      for (int j = 0; j < 7 ; ++j) {  
-        if (i+3<6&&(board[i][j]== board[i+1][j]&&board[i+1][j]== board[i+2][j]&&board[i+2][j]==board[i+3][j]&&board[i][j]!='.'))
-            if (board[i][j]==AI)
-                return +10;
-            else if (board[i][j]==OOP)
-                return -10;
-       }
-    }
-     for (int i=0; i<3;++i){
-       for (int j=0; j<4;++j){
-        if (i-3>=0&&j+3<7 &&(board[i][j]== board[i-1][j+1]==board[i-2][j+2]==board[i-3][j+3]&&board[i][j]!='.') )
-              if (board[i][j]==AI)
-                  return +10;
-              else if (board[i][j]==OOP)
-                  return -10;
-        if (i+3<6 && j+3<7 &&(board[i][j]== board[i+1][j+1]== board[i+2][j+2]==board[i+3][j+3]&&board[i][j]!='.') )
-               if (board[i][j]==AI)
-                  return +10;
-              else if (board[i][j]==OOP)
-                  return -10;
+    if (windows[0] == 0) {
+        // Directions as (column step, height step): horizontal, vertical and both diagonals
+        const int steps[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+        int n = 0;
+
+        for (const auto& step : steps)
+            for (int col = 0; col < FOUR_Board::WIDTH; ++col)
+                for (int h = 0; h < FOUR_Board::HEIGHT; ++h) {
+                    int endCol = col + 3 * step[0], endH = h + 3 * step[1];
+                    if (endCol >= FOUR_Board::WIDTH || endH < 0 || endH >= FOUR_Board::HEIGHT)
+                        continue;
+
+                    for (int k = 0; k < 4; ++k)
+                        windows[n] |= FOUR_Board::cell_bit(col + k * step[0], h + k * step[1]);
+                    ++n;
+                }
     }
-   }
-   return 0;
- 
-    
 }
-  
-/*In Connect Four the last move should fall to the bottom
-so this function returns the last available row*/
 
-int FOUR_UI::get_next_available_row(const vector<vector<char>>& board, int col)
+int FOUR_Engine::best_move(FOUR_Board* board, char toMove, int maxDepth)
 {
-    for (int i = 5; i >= 0; --i)
-        if (board[i][col] == '.')
-            return i;
-    return -1;
+    this->board = board;
+
+    int best = -1;
+    for (int col : COLUMN_ORDER) {
+        if (!board->can_play(col)) continue;
+        if (board->is_winning_move(col, toMove)) return col;
+        if (best < 0) best = col;
+    }
+
+    int empties = FOUR_Board::WIDTH * FOUR_Board::HEIGHT - board->get_moves();
+    uint64_t key = board->get_bits('X') + board->get_mask();
+
+    for (int depth = 1; depth <= maxDepth && depth <= empties; ++depth) {
+        negamax(toMove, depth, -WIN, WIN);
+
+        const Entry& e = slot_of(key);
+        if (e.key == key && e.move >= 0) best = e.move;
+    }
+    return best;
 }
 
-int FOUR_UI::minimax( vector<vector<char>>& board, int depth, int alpha, int beta, bool isMax)
+int FOUR_Engine::negamax(char side, int depth, int alpha, int beta)
 {
-    int score = evaluate(board);
-    //Winning sooner → better score
-    // losing later → less bad
-    if (score == 10) {return score - depth;} 
-    if (score == -10) {return score + depth;}
-    if (!isMovesLeft(board)) return 0;
-    if (depth > 6) return score;
-
-    if (isMax)
-    {
-        int best = INT_MIN;
-        for (int j = 0; j < 7; j++)
-        {
-
-               int i = get_next_available_row(board, j);
-               if (i != -1){
-                board[i][j] = AI;
-                best = max(best, minimax(board, depth+1, alpha, beta, false));
-                board[i][j] = '.';
-                alpha = max(alpha, best);
-                if (beta <= alpha) {break;}// prune this branch.
-               }  
+    char other = (side == 'X') ? 'O' : 'X';
+    int moves = board->get_moves();
+
+    // A win on the spot needs no search
+    for (int col = 0; col < FOUR_Board::WIDTH; ++col)
+        if (board->can_play(col) && board->is_winning_move(col, side))
+            return WIN - (moves + 1);
+
+    if (moves == FOUR_Board::WIDTH * FOUR_Board::HEIGHT) return 0;
+    if (depth == 0) return evaluate(side);
+
+    // X's stones + mask identify the position (the side to move follows from the stone count)
+    uint64_t key = board->get_bits('X') + board->get_mask();
+    Entry& slot = slot_of(key);
+    int ttMove = -1;
+
+    if (slot.key == key) {
+        ttMove = slot.move;
+        if (slot.depth >= depth) {
+            if (slot.bound == EXACT) return slot.value;
+            if (slot.bound == LOWER && slot.value >= beta) return slot.value;
+            if (slot.bound == UPPER && slot.value <= alpha) return slot.value;
         }
-        return best;
     }
-    else
-    {
-        int best =INT_MAX;
-        for (int j = 0; j < 7; j++)
-        {
-            int i = get_next_available_row(board, j);
-            if (i != -1)
-            {
-                board[i][j] = OOP;
-                best = min(best, minimax( board, depth+1, alpha, beta, true));
-                board[i][j] = '.';
-                beta = min(beta, best);
-                if (beta <= alpha) break;
-            }
+
+    // Transposition table move first, then centre-first
+    int order[FOUR_Board::WIDTH + 1];
+    int count = 0;
+    if (ttMove >= 0 && board->can_play(ttMove)) order[count++] = ttMove;
+    for (int col : COLUMN_ORDER)
+        if (col != ttMove && board->can_play(col)) order[count++] = col;
+
+    int origAlpha = alpha;
+    int best = -WIN, bestMove = order[0];
+
+    for (int i = 0; i < count; ++i) {
+        board->drop(order[i], side);
+        int val = -negamax(other, depth - 1, -beta, -alpha);
+        board->undo(order[i]);
+
+        if (val > best) {
+            best = val;
+            bestMove = order[i];
         }
-        return best;
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
     }
+
+    slot.key = key;
+    slot.value = (int16_t)best;
+    slot.depth = (uint8_t)depth;
+    slot.move = (int8_t)bestMove;
+    slot.bound = best <= origAlpha ? UPPER : (best >= beta ? LOWER : EXACT);
+
+    return best;
 }
 
-int  FOUR_UI::findBestMove(vector<vector<char>> board)
+uint64_t FOUR_Engine::threat_cells(uint64_t own, uint64_t mask)
 {
-   int bestVal = INT_MIN;
-   int bestMove=-1;
- 
+    // Vertical: three stacked stones, the cell above them
+    uint64_t r = (own << 1) & (own << 2) & (own << 3);
 
-    int alpha = INT_MIN, beta = INT_MAX;
+    // The other directions: a cell completes four if three of the four cells
+    // around it in that line are own stones (xxx., xx.x, x.xx, .xxx)
+    for (int shift : {FOUR_Board::HEIGHT + 1, FOUR_Board::HEIGHT, FOUR_Board::HEIGHT + 2}) {
+        uint64_t p = (own << shift) & (own << 2 * shift);
+        r |= p & (own << 3 * shift);
+        r |= p & (own >> shift);
+        p = (own >> shift) & (own >> 2 * shift);
+        r |= p & (own >> 3 * shift);
+        r |= p & (own << shift);
+    }
 
-    for (int j = 0; j < 7; j++)
-    {
-        int i = get_next_available_row(board, j);
-        if (i != -1)
-        {
-            board[i][j] = AI;
-            int moveVal = minimax(board, 0, alpha, beta, false);
-            board[i][j] = '.';
-            if (moveVal > bestVal)
-            {
-               bestVal = moveVal;
-               bestMove = j;
-            }
-            alpha = max(alpha, bestVal);
-        }
+    return r & (BOARD_MASK ^ mask);
+}
+
+int FOUR_Engine::evaluate(char side) const
+{
+    uint64_t x = board->get_bits('X');
+    uint64_t o = board->get_bits('O');
+    uint64_t mask = x | o;
+    int score = 0;
+
+    // Open twos and threes: windows holding stones of one side only
+    for (uint64_t w : windows) {
+        int nx = __builtin_popcountll(w & x);
+        int no = __builtin_popcountll(w & o);
+        if (no == 0) score += (nx == 2) ? 2 : (nx == 3) ? 5 : 0;
+        else if (nx == 0) score -= (no == 2) ? 2 : (no == 3) ? 5 : 0;
     }
 
-    return bestMove;
+    // Threat parity: with X moving first, zugzwang at the end of the game
+    // lets X claim odd-row threats and O even-row threats
+    uint64_t tx = threat_cells(x, mask);
+    uint64_t to = threat_cells(o, mask);
+    score += 12 * __builtin_popcountll(tx & ODD_ROWS) + 4 * __builtin_popcountll(tx & ~ODD_ROWS);
+    score -= 12 * __builtin_popcountll(to & ~ODD_ROWS) + 4 * __builtin_popcountll(to & ODD_ROWS);
+
+    return (side == 'X') ? score : -score;
 }
@@ -2,51 +2,159 @@
 #ifndef FOUR_H
 #define FOUR_H
 #include "../../header/BoardGame_Classes.h"
+#include <cstdint>
+#include <vector>
 using namespace std;
 
 
+/**
+ * @brief Connect-Four board backed by per-column heights and two bitboards.
+ *
+ * Each column takes 7 bits (6 cells plus a sentinel bit), bit = 7 * col + height,
+ * so a four-in-a-row is found with three shift-and-and steps per direction.
+ * Drop, undo and legality are O(1), which lets the engine search the live board.
+ * The character matrix is kept in sync for display only.
+ */
 class FOUR_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
-    
+    uint64_t bitsX = 0;      ///< Stones of X.
+    uint64_t bitsO = 0;      ///< Stones of O.
+    int heights[7]{};        ///< Stones in each column.
 
 public:
-   int last_row[7]{};
+    static const int WIDTH = 7;     ///< Number of columns.
+    static const int HEIGHT = 6;    ///< Number of rows.
+
     FOUR_Board();
+    /**
+     * @brief Drop a stone into column move->get_y(); symbol 0 takes back the top stone of that column.
+     */
     bool update_board(Move<char>* move)override;
     bool is_win(Player<char>* player)override;
     bool is_lose(Player<char>* player) { return false; }
     bool is_draw(Player<char>* player)override;
     bool game_is_over(Player<char>* player)override;
-    int get_last_row(int y){
-           return 5-last_row[y];
-    }
-    int increase_last_row(int y){
-           return 5-last_row[y]++;
-    }
-     int decrease_last_row(int y){
-           return 5-last_row[y]--;
-    }
-
-    
+
+    /** @brief True if the column exists and still has room for a stone. */
+    bool can_play(int col) const { return col >= 0 && col < WIDTH && heights[col] < HEIGHT; }
+
+    /** @brief Drop a stone of the given symbol (the column must be playable). */
+    void drop(int col, char mark);
+
+    /** @brief Take back the top stone of the column (the column must not be empty). */
+    void undo(int col);
+
+    /** @brief True if dropping the symbol into the column completes four. */
+    bool is_winning_move(int col, char mark) const;
+
+    /** @brief Bitboard of the symbol's stones. */
+    uint64_t get_bits(char mark) const { return mark == 'X' ? bitsX : bitsO; }
+
+    /** @brief Bitboard of all stones. */
+    uint64_t get_mask() const { return bitsX | bitsO; }
+
+    /** @brief Number of stones in the column. */
+    int get_height(int col) const { return heights[col]; }
+
+    /** @brief Number of stones on the board. */
+    int get_moves() const { return n_moves; }
+
+    /** @brief Bit of the cell at the given height of a column. */
+    static uint64_t cell_bit(int col, int height) { return uint64_t(1) << (col * (HEIGHT + 1) + height); }
+
+    /** @brief True if the bitboard contains four in a row in any direction. */
+    static bool has_four(uint64_t bits);
+};
+
+
+/**
+ * @brief Connect-Four search engine working directly on a FOUR_Board.
+ *
+ * Negamax alpha-beta over the board's O(1) drop/undo: moves are ordered
+ * centre-first with the transposition table move tried before them, the
+ * search deepens iteratively and leaves are scored by a threat evaluator.
+ */
+class FOUR_Engine {
+public:
+    /**
+     * @brief Construct the engine and allocate its transposition table.
+     * @param tableBits log2 of the number of transposition table entries.
+     */
+    explicit FOUR_Engine(int tableBits = 20);
+
+    /**
+     * @brief Search the board with iterative deepening (the board is restored before returning).
+     * @param board The live game board.
+     * @param toMove The symbol of the side to move.
+     * @param maxDepth The final search depth in plies.
+     * @return The best column for the side to move.
+     */
+    int best_move(FOUR_Board* board, char toMove, int maxDepth);
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = 0;       ///< Position key (X stones + mask), 0 when empty.
+        int16_t value = 0;      ///< Stored score.
+        uint8_t depth = 0;      ///< Depth the score was searched to.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+        int8_t move = -1;       ///< Best column found in this position.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @brief Negamax alpha-beta search.
+     * @return Score for the side to move: WIN - stones for a forced win, the static evaluation at the horizon.
+     */
+    int negamax(char side, int depth, int alpha, int beta);
+
+    /**
+     * @brief Static evaluation of a non-terminal position.
+     *
+     * Counts the open twos and threes of each side over all 69 four-cell windows
+     * and scores the empty cells that would complete a four by row parity:
+     * X (who moves first) profits from threats on odd rows, O from even rows.
+     * @param side The symbol of the side to move.
+     * @return Score for the side to move, well inside (-WIN + 42, WIN - 42).
+     */
+    int evaluate(char side) const;
+
+    /**
+     * @brief Empty cells that would complete a four for the given stones.
+     * @param own The stones of one side.
+     * @param mask All stones on the board.
+     */
+    static uint64_t threat_cells(uint64_t own, uint64_t mask);
+
+    /** @brief The table slot of the board's current position. */
+    Entry& slot_of(uint64_t key) { return table[(key * 0x9E3779B97F4A7C15ULL >> 16) & tableMask]; }
+
+    static const int WIN = 10000;               ///< Base score of a win (minus the stones played).
+
+    static uint64_t windows[69];                ///< Every four-cell line on the board.
+    static const uint64_t BOARD_MASK;           ///< All 42 playable cells (no sentinel bits).
+    static const uint64_t ODD_ROWS;             ///< Rows 1, 3 and 5 counted from the bottom.
+
+    FOUR_Board* board = nullptr;                ///< Board being searched.
+    vector<Entry> table;                        ///< Transposition table (power of two size).
+    uint64_t tableMask;                         ///< Index mask for the table.
 };
 
 
 class FOUR_UI : public UI<char> {
 private:
-char AI, OOP;
+    FOUR_Engine engine;     ///< Search engine used by the computer player.
+    int searchDepth = 10;   ///< Plies searched per computer move.
 public:
    
     FOUR_UI();
     ~FOUR_UI() {};
     Player<char>* create_player(string& name, char symbol, PlayerType type)override;
     Move<char>* get_move(Player<char>* player) override;
-    //=====For AI====
-    bool isMovesLeft( vector<vector<char>>& matrix);
-    int evaluate( vector<vector<char>>& matrix);
-    int minimax(vector<vector<char>>& matrix, int depth, int alpha, int beta, bool isMax);
-    int findBestMove( vector<vector<char>> board);
-    int get_next_available_row(const vector<vector<char>>& board, int col);
 };
 
 #endif 
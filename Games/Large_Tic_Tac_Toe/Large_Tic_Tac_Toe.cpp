@@ -1,6 +1,11 @@
 #include "Large_Tic_Tac_Toe.h"
+#include "../../header/Random.h"
+#include "../../header/Symmetry.h"
 
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
 
 // ============================================================================
 // Activation Functions
@@ -35,6 +40,16 @@ auto linear_derivative = [](double x) { return 1.0; };
  */
 uint32_t Large_XO_Board::win3Masks[48] {};
 
+/**
+ * @brief The same 48 patterns grouped by cell: every mask that covers a cell
+ * is listed under that cell (at most 12 for the center cell).
+ *
+ * Used to update the line counts incrementally: a move can only complete
+ * or break the lines passing through its own cell.
+ */
+uint32_t Large_XO_Board::cellMasks[25][12] {};
+uint8_t Large_XO_Board::cellMaskCount[25] {};
+
 // --- 1. Constructors ---
 
 Large_XO_Board::Large_XO_Board()
@@ -80,6 +95,14 @@ Large_XO_Board::Large_XO_Board()
                 ++maskIdx;
             }
         }
+
+        // Per-cell lists: register each mask under the three cells it covers
+        for (const auto& mask : win3Masks) {
+            for (uint32_t bits = mask; bits; bits &= bits - 1) {
+                int idx = __builtin_ctz(bits);
+                cellMasks[idx][cellMaskCount[idx]++] = mask;
+            }
+        }
     }
 }
 
@@ -107,6 +130,16 @@ int Large_XO_Board::getMoveCount()
     return nMoves;
 }
 
+uint32_t Large_XO_Board::getBitBoard(char sym)
+{
+    return sym == 'X' ? boardX : boardO;
+}
+
+uint32_t Large_XO_Board::getOccupied()
+{
+    return boardXO;
+}
+
 // --- 3. Mutators (Write/Update Operations) ---
 
 bool Large_XO_Board::updateCell(size_t r, size_t c, char s)
@@ -115,13 +148,17 @@ bool Large_XO_Board::updateCell(size_t r, size_t c, char s)
     size_t idx = r * 5 + c;
     
     // Check bounds and if cell is already occupied (unless undoing)
-    if (idx > 25 || (boardXO & (1u << idx) && s != 0))
+    if (idx >= 25 || (boardXO & (1u << idx) && s != 0))
         return false;
     
     // Handle undo operation (s == 0 means remove piece)
     if (s == 0) {
         --nMoves;
         uint32_t mask = ~(1u << idx);  // Create mask with 0 at idx, 1s elsewhere
+
+        // Lines through this cell are broken by removing the piece
+        if (boardX & (1u << idx)) winsX -= linesThrough(idx, boardX);
+        if (boardO & (1u << idx)) winsO -= linesThrough(idx, boardO);
         
         boardX &= mask;                // Clear X's bit
 
@@ -131,11 +168,15 @@ bool Large_XO_Board::updateCell(size_t r, size_t c, char s)
         return true;
     }
 
-    // Place piece on board using bitwise OR
-    if (s == 'X')
+    // Place piece on board using bitwise OR, counting the lines it completes
+    if (s == 'X') {
         boardX |= (1u << idx);
-    else
+        winsX += linesThrough(idx, boardX);
+    }
+    else {
         boardO |= (1u << idx);
+        winsO += linesThrough(idx, boardO);
+    }
 
     boardXO |= (1u << idx);
     
@@ -188,18 +229,29 @@ bool Large_XO_Board::is_draw(Player<char>* player)
 
 float Large_XO_Board::countWin(char sym)
 {
-    float score = 0;
-    
-    // Get the appropriate bitboard for this symbol
-    uint32_t& tempBoard = (sym == 'X' ? boardX : boardO);
-    
-    // Check each winning pattern
-    for (const auto& mask : win3Masks) {
-        // If (board & mask) == mask, then all 3 bits in the pattern are set
-        score += (tempBoard & mask) == mask;
-    }
-    
-    return score;
+    // Maintained by updateCell on every place and undo
+    return static_cast<float>(sym == 'X' ? winsX : winsO);
+}
+
+int Large_XO_Board::linesThrough(size_t idx, uint32_t bits)
+{
+    int lines = 0;
+
+    // If (bits & mask) == mask, then all 3 cells of the pattern are set
+    for (int i = 0; i < cellMaskCount[idx]; ++i)
+        lines += (bits & cellMasks[idx][i]) == cellMasks[idx][i];
+
+    return lines;
+}
+
+int Large_XO_Board::openLinesThrough(size_t idx, uint32_t blockers)
+{
+    int lines = 0;
+
+    for (int i = 0; i < cellMaskCount[idx]; ++i)
+        lines += (blockers & cellMasks[idx][i]) == 0;
+
+    return lines;
 }
 
 void Large_XO_Board::encode(char ai, Matrix<double>& input)
@@ -230,6 +282,169 @@ void Large_XO_Board::encode(char ai, Matrix<double>& input)
     }
 }
 
+// ============================================================================
+// Large_XO_Endgame Implementation
+// ============================================================================
+
+/// All 25 cells of the 5x5 board.
+static constexpr uint32_t FULL_BOARD = 0x1FFFFFF;
+
+Large_XO_Endgame::Large_XO_Endgame(int tableBits)
+    : table(size_t(1) << tableBits), tableMask((uint64_t(1) << tableBits) - 1)
+{
+}
+
+std::pair<int, int> Large_XO_Endgame::solve(Large_XO_Board* board, char sym)
+{
+    uint32_t own = board->getBitBoard(sym);
+    uint32_t other = board->getBitBoard(sym == 'X' ? 'O' : 'X');
+    int movesLeft = 24 - board->getMoveCount();
+
+    // Margin already on the board, plus the exact margin of the remaining moves
+    int current = (int)board->countWin(sym) - (int)board->countWin(sym == 'X' ? 'O' : 'X');
+    int future = search(own, other, movesLeft, -64, 64);
+
+    uint64_t key = own | (uint64_t(other) << 25);
+    const Entry& e = table[(key * 0x9E3779B97F4A7C15ULL >> 20) & tableMask];
+    int move = (e.key == key) ? e.move : -1;
+
+    // The root entry can only be overwritten by a colliding position; fall back to the first empty cell
+    if (move < 0 && movesLeft > 0)
+        move = __builtin_ctz(~(own | other) & FULL_BOARD);
+
+    return {move, current + future};
+}
+
+int Large_XO_Endgame::search(uint32_t own, uint32_t other, int movesLeft, int alpha, int beta)
+{
+    if (movesLeft == 0) return 0;
+
+    // The side to move is implied by the piece count, so (own, other) identifies the position
+    uint64_t key = own | (uint64_t(other) << 25);
+    Entry& slot = table[(key * 0x9E3779B97F4A7C15ULL >> 20) & tableMask];
+    int ttMove = -1;
+
+    if (slot.key == key) {
+        ttMove = slot.move;
+        if (slot.bound == EXACT) return slot.value;
+        if (slot.bound == LOWER && slot.value >= beta) return slot.value;
+        if (slot.bound == UPPER && slot.value <= alpha) return slot.value;
+    }
+
+    // Generate moves from the empty mask and score them for ordering:
+    // lines completed, opponent lines blocked, then open lines through the cell.
+    int moves[25], gains[25], keys[25];
+    int count = 0;
+
+    for (uint32_t empty = ~(own | other) & FULL_BOARD; empty; empty &= empty - 1) {
+        int idx = __builtin_ctz(empty);
+        int gain = Large_XO_Board::linesThrough(idx, own | (1u << idx));
+        int block = Large_XO_Board::linesThrough(idx, other | (1u << idx));
+        int open = Large_XO_Board::openLinesThrough(idx, other);
+
+        moves[count] = idx;
+        gains[count] = gain;
+        keys[count] = (idx == ttMove) ? 1 << 20 : ((gain + block) << 4) + open;
+        ++count;
+    }
+
+    // Insertion sort: at most 25 moves, best key first
+    for (int i = 1; i < count; ++i) {
+        int m = moves[i], g = gains[i], k = keys[i], j = i - 1;
+        for (; j >= 0 && keys[j] < k; --j) {
+            moves[j + 1] = moves[j]; gains[j + 1] = gains[j]; keys[j + 1] = keys[j];
+        }
+        moves[j + 1] = m; gains[j + 1] = g; keys[j + 1] = k;
+    }
+
+    int origAlpha = alpha;
+    int best = -1000, bestMove = -1;
+
+    for (int i = 0; i < count; ++i) {
+        uint32_t bit = 1u << moves[i];
+        int val = gains[i] - search(other, own | bit, movesLeft - 1, gains[i] - beta, gains[i] - alpha);
+
+        if (val > best) {
+            best = val;
+            bestMove = moves[i];
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    slot.key = key;
+    slot.value = (int8_t)best;
+    slot.move = (int8_t)bestMove;
+    slot.bound = best <= origAlpha ? UPPER : (best >= beta ? LOWER : EXACT);
+
+    return best;
+}
+
+// ============================================================================
+// Large_XO_Book Implementation
+// ============================================================================
+
+bool Large_XO_Book::load(const std::string& path)
+{
+    entries.clear();
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+
+    std::streamsize bytes = in.tellg();
+    in.seekg(0);
+
+    entries.resize(static_cast<size_t>(bytes) / sizeof(uint64_t));
+    if (!in.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(uint64_t))) {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Large_XO_Book::save(const std::string& path, std::vector<uint64_t>& entries)
+{
+    std::sort(entries.begin(), entries.end());
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(uint64_t));
+    return static_cast<bool>(out);
+}
+
+int Large_XO_Book::probe(uint32_t boardX, uint32_t boardO) const
+{
+    if (entries.empty()) return -1;
+
+    int transform;
+    uint64_t key = canonical(boardX, boardO, transform);
+
+    // Entries are sorted by key first, so the position's entry is the first one >= key << 5
+    auto it = std::lower_bound(entries.begin(), entries.end(), key << 5);
+    if (it == entries.end() || (*it >> 5) != key) return -1;
+
+    // The stored move is in the canonical orientation; map it back onto this board
+    return transformCell(static_cast<int>(*it & 31), transform, true);
+}
+
+uint64_t Large_XO_Book::canonical(uint32_t boardX, uint32_t boardO, int& transform)
+{
+    uint64_t x = boardX, o = boardO;
+    transform = Symmetry<5>::canonical_pair(x, o);
+    return x | (o << 25);
+}
+
+uint32_t Large_XO_Book::transformBits(uint32_t bits, int transform)
+{
+    return static_cast<uint32_t>(Symmetry<5>::transform(bits, transform));
+}
+
+int Large_XO_Book::transformCell(int idx, int transform, bool inverse)
+{
+    return Symmetry<5>::transform_cell(idx, transform, inverse);
+}
+
 // ============================================================================
 // Large_XO_UI Implementation
 // ============================================================================
@@ -239,6 +454,11 @@ void Large_XO_Board::encode(char ai, Matrix<double>& input)
 Large_XO_UI::Large_XO_UI()
     : Custom_UI<char>("5x5 XO"s, 5)
 {
+    // Default move ordering: NN deep in the tree, killers/history near the leaves
+    orderer = [this](Large_XO_Board* b, char side, int depth, int* moves) {
+        return orderMoves(b, networkFor(side), side, depth, moves);
+    };
+
     // Define network architecture: Input(25) -> Hidden(128) -> Hidden(256) -> Hidden(128) -> Output(25)
     std::vector<int> layerSizes = {25, 512, 512, 512, 25};
     
@@ -265,6 +485,9 @@ Large_XO_UI::Large_XO_UI()
     } catch (const std::exception& e) {
         std::cerr << "Error initializing Large_XO_UI: " << e.what() << "\n";
     }
+
+    // Optional opening book; without it the opening is searched like any other position
+    book.load("book.bin");
 }
 
 // --- 2. Player Interaction ---
@@ -288,8 +511,8 @@ Move<char>* Large_XO_UI::get_move(Player<char>* player)
     }
     // Handle Computer (random) player
     else if (player->get_type() == PlayerType::COMPUTER) {
-        r = std::rand() % 5;
-        c = std::rand() % 5;
+        r = Random::local().below(5);
+        c = Random::local().below(5);
     }
     // Handle AI player
     else if (player->get_type() == PlayerType::AI) {
@@ -298,7 +521,21 @@ Move<char>* Large_XO_UI::get_move(Player<char>* player)
         // Cast board to get move count
         auto* board = dynamic_cast<Large_XO_Board*>(player->get_board_ptr());
         int movesMade = board->getMoveCount(); // You'll need to add this getter
-        
+
+        // Opening: positions generated offline by Large_XO_BookBuilder
+        int bookMove = book.probe(board->getBitBoard('X'), board->getBitBoard('O'));
+        if (bookMove >= 0) {
+            cout << "\n[R,c] = [ " << bookMove / 5 << ", " << bookMove % 5 << " ] (book)\n";
+            return new Move<char>(bookMove / 5, bookMove % 5, player->get_symbol());
+        }
+
+        // Late endgame: few empty cells left, solve the rest of the game exactly
+        if (25 - movesMade <= endgameEmpties) {
+            auto [idx, margin] = endgame.solve(board, player->get_symbol());
+            cout << "\n[R,c] = [ " << idx / 5 << ", " << idx % 5 << " ] (exact margin " << margin << ")\n";
+            return new Move<char>(idx / 5, idx % 5, player->get_symbol());
+        }
+
         // Dynamic depth based on game phase
         int depth;
         
@@ -315,11 +552,7 @@ Move<char>* Large_XO_UI::get_move(Player<char>* player)
             depth = 5;
         }
         
-        // Select appropriate network
-        if (player->get_symbol() == 'X')
-            move = bestMove(player, NNX, depth);
-        else
-            move = bestMove(player, NNO, depth);
+        move = bestMove(player, depth);
         
         r = move.first;
         c = move.second;
@@ -329,6 +562,16 @@ Move<char>* Large_XO_UI::get_move(Player<char>* player)
     return new Move<char>(r, c, player->get_symbol());
 }
 
+void Large_XO_UI::setEndgameThreshold(int empties)
+{
+    endgameEmpties = empties;
+}
+
+void Large_XO_UI::setMoveOrderer(MoveOrderer orderer)
+{
+    this->orderer = std::move(orderer);
+}
+
 void Large_XO_UI::display_board_matrix(const vector<vector<char>>& matrix) const
 {
     // Clear the screen first
@@ -369,236 +612,254 @@ void Large_XO_UI::display_board_matrix(const vector<vector<char>>& matrix) const
 // --- 3. AI Core Functions ---
 
 /**
- * @brief Determines the best move using hybrid Neural Network pruning + Minimax search.
+ * @brief Lower edge of a null window ending at bound: the next float below it.
+ * A fixed epsilon vanishes next to the +-10000 terminal scores, where floats
+ * are about 1e-3 apart, and would leave the scout search an empty window.
+ */
+static float nullWindowFloor(float bound)
+{
+    return std::nextafter(bound, -INFINITY);
+}
+
+/**
+ * @brief Determines the best move using hybrid Neural Network pruning + PVS search.
  * 
  * Strategy:
  * 1. Use Neural Network to rank all possible moves by predicted Q-values
- * 2. Only search the top 8 most promising moves (NN pruning)
- * 3. For each candidate, use minimax to calculate exact value
- * 4. Return the move with highest minimax value
+ * 2. Only search the top rootCandidates most promising moves (NN pruning)
+ * 3. Deepen the search one ply at a time inside an aspiration window
+ * 4. Return the move that was best in the deepest iteration
  * 
  * @param player The AI player making the move
- * @param NN The Neural Network (X or O) for heuristic evaluation
- * @param depth Maximum depth for minimax search tree
+ * @param depth Maximum depth for the search tree
  * @return Pair {row, col} of the optimal move
  */
-std::pair<int, int> Large_XO_UI::bestMove(Player<char>* player,
-                                          std::shared_ptr<NeuralNetwork>& NN, int depth)
+std::pair<int, int> Large_XO_UI::bestMove(Player<char>* player, int depth)
 {
     // Cast board to Large_XO_Board type to access bitboard methods
     auto* board = dynamic_cast<Large_XO_Board*>(player->get_board_ptr());
+
+    int idx = search(board, player->get_symbol(), depth).first;
+    std::pair<int, int> bestMove = {idx / 5, idx % 5};
+
+    // Output chosen move for debugging
+    cout << "\n[R,c] = [ " << bestMove.first << ", " << bestMove.second << " ]\n";
     
-    // Determine AI and opponent symbols
-    char ai = player->get_symbol();
-    char opp = (ai == 'X') ? 'O' : 'X';
+    return bestMove;
+}
 
-    // PHASE 1: Get neural network predictions for all positions
+std::pair<int, float> Large_XO_UI::search(Large_XO_Board* board, char side, int depth)
+{
+    char other = (side == 'X') ? 'O' : 'X';
+
+    // Fresh killers for this search; halve the history so older cutoffs fade out
+    for (auto& k : killers) k[0] = k[1] = -1;
+    for (auto& h : history)
+        for (auto& v : h) v >>= 1;
+
+    // Rank the root moves by the NN's Q-values and keep the most promising ones
     Matrix<double> input;
-    board->encode(ai, input);          // Convert board to NN input format
-    Matrix<double> out = NN->predict(input);   // Get Q-values for all 25 positions
+    board->encode(side, input);
+    Matrix<double> out = networkFor(side)->predict(input);
 
-    // PHASE 2: Build candidate list with Q-values
-    std::vector<std::pair<double, int>> candidates;
-    candidates.reserve(25);  // Pre-allocate to avoid reallocations
-    
-    for (int i = 0; i < 25; ++i) {
-        int r = i / 5;
-        int c = i % 5;
-        
-        // Only add empty cells as candidates
-        if (board->getCell(r, c) == board->getEmptyCell()) {
-            candidates.push_back({out(i, 0), i});  // {Q-value, board_index}
-        }
+    int candidates[25];
+    double qValues[25];
+    int count = 0;
+
+    for (uint32_t empty = ~board->getOccupied() & 0x1FFFFFF; empty; empty &= empty - 1) {
+        candidates[count] = __builtin_ctz(empty);
+        qValues[count] = out(candidates[count], 0);
+        ++count;
     }
-    
-    // PHASE 3: Sort by Q-value (descending) and select top 8
-    int searchCount = std::min((int)candidates.size(), 8);
-    sort(candidates.rbegin(), candidates.rend());  // Highest Q-values first
-    
-    std::pair<int, int> bestMove = {-1, -1};
-    float bestVal = -1e9;
 
-    // PHASE 4: Use minimax to evaluate each candidate precisely
-    for (int i = 0; i < searchCount; ++i) {
-        int idx = candidates[i].second;  // Get board index from candidate
-        int r = idx / 5;
-        int c = idx % 5;
+    sortMoves(candidates, qValues, count);
+    count = std::min(count, rootCandidates);
+
+    int best = candidates[0];
+    float score = 0.0f;
+
+    for (int d = 1; d <= depth; ++d) {
+        // The first iteration has no previous score to centre a window on
+        float alpha = (d == 1) ? -1e9f : score - aspirationWindow;
+        float beta  = (d == 1) ?  1e9f : score + aspirationWindow;
+
+        while (true) {
+            float a = alpha;
+            int iterBest = candidates[0];
+            float iterScore = -1e9f;
+
+            for (int i = 0; i < count; ++i) {
+                int r = candidates[i] / 5;
+                int c = candidates[i] % 5;
+                float val;
+
+                board->updateCell(r, c, side);
+                if (i == 0) {
+                    val = -pvs(board, other, d - 1, -beta, -a);
+                }
+                else {
+                    val = -pvs(board, other, d - 1, nullWindowFloor(-a), -a);
+                    if (val > a && val < beta)
+                        val = -pvs(board, other, d - 1, -beta, -a);
+                }
+                board->updateCell(r, c, 0);
+
+                if (val > iterScore) {
+                    iterScore = val;
+                    iterBest = candidates[i];
+                }
+                if (val > a) a = val;
+                if (a >= beta) break;
+            }
 
-        // Try this move
-        board->updateCell(r, c, ai);
-        
-        // Calculate exact value using minimax (opponent's turn next)
-        float val = minimax(board, NN, false, depth - 1, -1e9, 1e9, ai, opp);
-        
-        // Undo the move to restore board state
-        board->updateCell(r, c, 0);
+            // Outside the window: open the failing side and search this depth again
+            if (iterScore <= alpha && alpha > -1e9f) { alpha = -1e9f; continue; }
+            if (iterScore >= beta && beta < 1e9f)    { beta = 1e9f;  continue; }
 
-        // Track the best move found so far
-        if (val > bestVal) {
-            bestVal = val;
-            bestMove = {r, c};
+            best = iterBest;
+            score = iterScore;
+            break;
+        }
+
+        // Search the previous best move first in the next iteration
+        for (int i = 0; i < count; ++i) {
+            if (candidates[i] == best) {
+                std::swap(candidates[0], candidates[i]);
+                break;
+            }
         }
     }
 
-    // Output chosen move for debugging
-    cout << "\n[R,c] = [ " << bestMove.first << ", " << bestMove.second << " ]\n";
-    
-    return bestMove;
+    return {best, score};
 }
 
 /**
- * @brief Minimax search with Alpha-Beta pruning and Neural Network move ordering.
+ * @brief Principal variation search (negamax form) with Alpha-Beta pruning.
  * 
- * Two search strategies based on depth:
- * - depth >= 2: Use NN to order moves (better pruning, more NN calls)
- * - depth < 2: Brute force all moves (simpler, faster for shallow search)
+ * The first move, the one the orderer likes best, is searched with the full
+ * window; every other move only has to be proven no better than it with a
+ * null window, and is re-searched when that proof fails. The default orderer
+ * uses the NN deep in the tree and killers/history near the leaves.
  * 
  * @param board Current board state
- * @param NN Neural Network for position evaluation
- * @param maximize True if maximizing player's turn (AI), false for minimizer (opponent)
+ * @param side Symbol of the side to move
  * @param depth Remaining search depth
- * @param alpha Alpha value for pruning (best maximizer can guarantee)
- * @param beta Beta value for pruning (best minimizer can guarantee)
- * @param ai AI player symbol
- * @param opp Opponent player symbol
- * @return Minimax evaluation of current position
+ * @param alpha Lower bound of the window (best the side to move can guarantee)
+ * @param beta Upper bound of the window (best the opponent can guarantee)
+ * @return Evaluation of the current position for the side to move
  */
-float Large_XO_UI::minimax(Large_XO_Board* board, std::shared_ptr<NeuralNetwork>& NN,
-                           bool maximize, int depth, float alpha, float beta,
-                           char ai, char opp)
+float Large_XO_UI::pvs(Large_XO_Board* board, char side, int depth, float alpha, float beta)
 {
+    char other = (side == 'X') ? 'O' : 'X';
+
     // BASE CASE: Terminal state or depth limit reached
     if (depth == 0 || board->game_is_over(nullptr)) {
-        return evaluate(board, NN, ai, opp);
+        return evaluate(board, networkFor(side), side, other);
     }
-    
-    // DEEP SEARCH (depth >= 2): Use Neural Network to order moves
-    // This dramatically improves alpha-beta pruning effectiveness
-    if (depth >= 2) {
-        // Get NN predictions for move ordering
-        Matrix<double> input;
-        board->encode(maximize ? ai : opp, input);  // Encode for current player
-        Matrix<double> out = NN->predict(input);
-        
-        // Build ordered list of available moves with their Q-values
-        std::vector<std::pair<double, int>> moves;
-        moves.reserve(25);
-        
-        for (int idx = 0; idx < 25; ++idx) {
-            int r = idx / 5;
-            int c = idx % 5;
-            if (board->getCell(r, c) == board->getEmptyCell()) {
-                moves.push_back({out(idx, 0), idx});
-            }
+
+    // Generate and order the moves of the side to move
+    int moves[25];
+    int count = orderer(board, side, depth, moves);
+
+    float bestEval = -1e9f;
+
+    for (int i = 0; i < count; ++i) {
+        int r = moves[i] / 5;
+        int c = moves[i] % 5;
+        float eval;
+
+        // Try move
+        board->updateCell(r, c, side);
+        if (i == 0) {
+            eval = -pvs(board, other, depth - 1, -beta, -alpha);
         }
-        
-        // Sort moves: best first for maximizer, worst first for minimizer
-        // This ordering helps alpha-beta prune more branches early
-        if (maximize)
-            std::sort(moves.rbegin(), moves.rend()); // Descending (best first)
-        else
-            std::sort(moves.begin(), moves.end());    // Ascending (worst first)
-        
-        // MAXIMIZING PLAYER (AI's turn)
-        if (maximize) {
-            float maxEval = -1e9;
-            for (const auto& [qval, idx] : moves) {
-                int r = idx / 5;
-                int c = idx % 5;
-                
-                // Try move
-                board->updateCell(r, c, ai);
-                float eval = minimax(board, NN, false, depth - 1, alpha, beta, ai, opp);
-                board->updateCell(r, c, 0);  // Undo
-                
-                // Update max value and alpha
-                maxEval = std::max(maxEval, eval);
-                alpha = std::max(alpha, eval);
-                
-                // Beta cutoff: minimizer can avoid this branch
-                if (beta <= alpha)
-                    break;
-            }
-            return maxEval;
-        } 
-        // MINIMIZING PLAYER (opponent's turn)
         else {
-            float minEval = 1e9;
-            for (const auto& [qval, idx] : moves) {
-                int r = idx / 5;
-                int c = idx % 5;
-                
-                // Try move
-                board->updateCell(r, c, opp);
-                float eval = minimax(board, NN, true, depth - 1, alpha, beta, ai, opp);
-                board->updateCell(r, c, 0);  // Undo
-                
-                // Update min value and beta
-                minEval = std::min(minEval, eval);
-                beta = std::min(beta, eval);
-                
-                // Alpha cutoff: maximizer can avoid this branch
-                if (beta <= alpha)
-                    break;
-            }
-            return minEval;
+            eval = -pvs(board, other, depth - 1, nullWindowFloor(-alpha), -alpha);
+            if (eval > alpha && eval < beta)
+                eval = -pvs(board, other, depth - 1, -beta, -alpha);
+        }
+        board->updateCell(r, c, 0);  // Undo
+
+        bestEval = std::max(bestEval, eval);
+        alpha = std::max(alpha, eval);
+
+        // Cutoff: remember the refutation for sibling nodes and later searches
+        if (alpha >= beta) {
+            recordCutoff(board, side, moves[i], depth);
+            break;
         }
     }
-    
-    // SHALLOW SEARCH (depth < 2): Simple brute-force without NN ordering
-    // At shallow depths, the overhead of NN calls isn't worth the benefit
-    
-    // MAXIMIZING PLAYER
-    if (maximize) {
-        float maxEval = -1e9;
-        
-        // Try all possible moves
-        for (int r = 0; r < 5; ++r) {
-            for (int c = 0; c < 5; ++c) {
-                if (board->getCell(r, c) != board->getEmptyCell())
-                    continue;
-                
-                // Try move
-                board->updateCell(r, c, ai);
-                float eval = minimax(board, NN, false, depth - 1, alpha, beta, ai, opp);
-                board->updateCell(r, c, 0);  // Undo
-                
-                // Update max and alpha
-                maxEval = std::max(maxEval, eval);
-                alpha = std::max(alpha, eval);
-                
-                // Beta cutoff
-                if (beta <= alpha)
-                    return maxEval;
-            }
+
+    return bestEval;
+}
+
+int Large_XO_UI::orderMoves(Large_XO_Board* board, std::shared_ptr<NeuralNetwork>& NN,
+                            char side, int depth, int* moves)
+{
+    uint32_t empty = ~board->getOccupied() & 0x1FFFFFF;
+    double keys[25];
+    int count = 0;
+
+    if (depth >= nnOrderDepth) {
+        // Deep node: rank the moves by the NN's Q-values for the side to move
+        Matrix<double> input;
+        board->encode(side, input);
+        Matrix<double> out = NN->predict(input);
+
+        for (; empty; empty &= empty - 1) {
+            moves[count] = __builtin_ctz(empty);
+            keys[count] = out(moves[count], 0);
+            ++count;
         }
-        return maxEval;
-    } 
-    // MINIMIZING PLAYER
+    }
     else {
-        float minEval = 1e9;
-        
-        // Try all possible moves
-        for (int r = 0; r < 5; ++r) {
-            for (int c = 0; c < 5; ++c) {
-                if (board->getCell(r, c) != board->getEmptyCell())
-                    continue;
-                
-                // Try move
-                board->updateCell(r, c, opp);
-                float eval = minimax(board, NN, true, depth - 1, alpha, beta, ai, opp);
-                board->updateCell(r, c, 0);  // Undo
-                
-                // Update min and beta
-                minEval = std::min(minEval, eval);
-                beta = std::min(beta, eval);
-                
-                // Alpha cutoff
-                if (beta <= alpha)
-                    return minEval;
-            }
+        // Shallow node: killers first, then the history score of the move
+        const int* killer = killers[board->getMoveCount()];
+        const int* hist = history[side == 'X' ? 0 : 1];
+
+        for (; empty; empty &= empty - 1) {
+            int idx = __builtin_ctz(empty);
+            moves[count] = idx;
+            keys[count] = (idx == killer[0]) ? 1e9 : (idx == killer[1]) ? 1e8 : hist[idx];
+            ++count;
+        }
+    }
+
+    sortMoves(moves, keys, count);
+    return count;
+}
+
+void Large_XO_UI::recordCutoff(Large_XO_Board* board, char side, int idx, int depth)
+{
+    int* killer = killers[board->getMoveCount()];
+    if (killer[0] != idx) {
+        killer[1] = killer[0];
+        killer[0] = idx;
+    }
+
+    // Cutoffs high in the tree are worth more than those near the leaves
+    history[side == 'X' ? 0 : 1][idx] += depth * depth;
+}
+
+std::shared_ptr<NeuralNetwork>& Large_XO_UI::networkFor(char side)
+{
+    return (side == 'X') ? NNX : NNO;
+}
+
+void Large_XO_UI::sortMoves(int* moves, double* keys, int count)
+{
+    // Insertion sort, descending by key: at most 25 moves, no allocation
+    for (int i = 1; i < count; ++i) {
+        int m = moves[i];
+        double k = keys[i];
+        int j = i - 1;
+
+        for (; j >= 0 && keys[j] < k; --j) {
+            moves[j + 1] = moves[j];
+            keys[j + 1] = keys[j];
         }
-        return minEval;
+        moves[j + 1] = m;
+        keys[j + 1] = k;
     }
 }
 
@@ -644,10 +905,8 @@ float Large_XO_UI::evaluate(Large_XO_Board* board, std::shared_ptr<NeuralNetwork
 
     // Find the maximum Q-value among valid moves
     // This represents the NN's estimate of the position's value
-    for (int idx = 0; idx < 25; ++idx) {
-        if (board->getCell(idx / 5, idx % 5) == board->getEmptyCell()) {
-            bestQ = std::max(bestQ, out(idx, 0));
-        }
+    for (uint32_t empty = ~board->getOccupied() & 0x1FFFFFF; empty; empty &= empty - 1) {
+        bestQ = std::max(bestQ, out(__builtin_ctz(empty), 0));
     }
     
     return static_cast<float>(bestQ);
@@ -7,6 +7,9 @@
 #include "../../Neural_Network/Include/NeuralNetwork.h"
 #include <memory>
 #include <cstdint>
+#include <vector>
+#include <string>
+#include <functional>
 
 /**
  * @brief Represents the 5x5 Tic-Tac-Toe Board, optimized using a Bit Board approach.
@@ -45,6 +48,19 @@ public:
      */
     int getMoveCount();
 
+    /**
+     * @brief Return the raw bitboard of one player.
+     * @param sym The symbol of the player ('X' or 'O').
+     * @return Bit mask with bit (5 * r + c) set for every cell owned by the player.
+     */
+    uint32_t getBitBoard(char sym);
+
+    /**
+     * @brief Return the bitboard of all occupied cells (X | O).
+     * @return Bit mask with bit (5 * r + c) set for every non-empty cell.
+     */
+    uint32_t getOccupied();
+
     // --- 3. Mutators (Write/Update Operations) ---
 
     /**
@@ -98,11 +114,27 @@ public:
 
     /**
      * @brief Count how many consequetive 3-in-a-row winning patterns the given symbol has.
-     * * This uses the stored bitmasks for fast counting.
+     * * The counts are maintained incrementally by updateCell, so this is a field read.
      * @param sym The symbol of the player ('X' or 'O').
      * @return Number of wins (float to be compatible with Neural Network value scales).
      */
     float countWin(char sym);
+
+    /**
+     * @brief Count the 3-in-a-row masks through a cell that are fully covered by a bitboard.
+     * @param idx The cell index (5 * r + c).
+     * @param bits The bitboard to test (typically a player's board including idx).
+     * @return Number of complete lines through idx.
+     */
+    static int linesThrough(size_t idx, uint32_t bits);
+
+    /**
+     * @brief Count the 3-in-a-row masks through a cell that contain none of the blocker bits.
+     * @param idx The cell index (5 * r + c).
+     * @param blockers The bitboard of cells that block a line (typically the opponent's board).
+     * @return Number of lines through idx that can still be completed.
+     */
+    static int openLinesThrough(size_t idx, uint32_t blockers);
     
     /**
      * @brief Encode the current board state into a Matrix format suitable for the Neural Network.
@@ -117,11 +149,138 @@ private:
     uint32_t boardO = 0;                                ///< Bit board mask for O's pieces.
     uint32_t boardXO = 0;                               ///< Bit board mask for all occupied cells (X | O).
     static uint32_t win3Masks[48];                ///< Store all the cobinations of 3 consequetive cells (winning lines).
+    static uint32_t cellMasks[25][12];                  ///< The win3Masks passing through each cell.
+    static uint8_t cellMaskCount[25];                   ///< Number of valid entries in cellMasks per cell.
+    int winsX = 0;                                      ///< Number of completed 3-in-a-rows of X.
+    int winsO = 0;                                      ///< Number of completed 3-in-a-rows of O.
     char emptyCell;                                     ///< Empty Cell value, typically '.'.
     int nMoves = 0;                                     ///< Number of Moves that has been made.
 };
 
 
+/**
+ * @brief Exact endgame solver for the 5x5 board.
+ * * Once only a few cells are empty the remaining tree is small enough to be
+ * solved exactly. The solver works directly on the X/O bitboards using negamax
+ * alpha-beta, generates moves by iterating the set bits of the empty mask and
+ * caches results in a transposition table. Scores are exact final margins
+ * (own 3-in-a-rows minus opponent 3-in-a-rows).
+ */
+class Large_XO_Endgame
+{
+public:
+    /**
+     * @brief Construct the solver and allocate its transposition table.
+     * @param tableBits log2 of the number of transposition table entries.
+     */
+    explicit Large_XO_Endgame(int tableBits = 20);
+
+    /**
+     * @brief Solve the current position exactly for the side to move.
+     * @param board The board to solve (left unchanged).
+     * @param sym The symbol of the side to move.
+     * @return A pair {cell index (5 * r + c), exact final score margin for sym}.
+     */
+    std::pair<int, int> solve(Large_XO_Board* board, char sym);
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = ~0ULL;   ///< Position key (own | other << 25), ~0 when empty.
+        int8_t value = 0;       ///< Stored margin of the remaining moves.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+        int8_t move = -1;       ///< Best move found in this position.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @brief Negamax alpha-beta over the remaining moves.
+     * @param own Bitboard of the side to move.
+     * @param other Bitboard of the opponent.
+     * @param movesLeft Number of moves still to be played before the game ends.
+     * @param alpha Lower bound of the search window.
+     * @param beta Upper bound of the search window.
+     * @return Margin (own lines - opponent lines) produced by the remaining moves.
+     */
+    int search(uint32_t own, uint32_t other, int movesLeft, int alpha, int beta);
+
+    std::vector<Entry> table;                   ///< Transposition table (power of two size).
+    uint64_t tableMask;                         ///< Index mask for the table.
+};
+
+
+/**
+ * @brief Opening book for the 5x5 board, generated offline by Large_XO_BookBuilder.
+ * * The book file is a sorted array of 64-bit entries (key << 5 | move), where key
+ * is the canonical position (X bits | O bits << 25) over the 8 board symmetries
+ * and move is the chosen cell in the canonical orientation. Lookups are a
+ * binary search; a missing file simply leaves the book empty.
+ */
+class Large_XO_Book
+{
+public:
+    /**
+     * @brief Load a book file, replacing the current contents.
+     * @param path The file to read (e.g. "book.bin").
+     * @return True if the file was read, otherwise false (the book is left empty).
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Write a list of entries as a sorted book file.
+     * @param path The file to write.
+     * @param entries The entries (key << 5 | move); sorted in place.
+     * @return True if the file was written.
+     */
+    static bool save(const std::string& path, std::vector<uint64_t>& entries);
+
+    /**
+     * @brief Look up the book move of a position.
+     * @param boardX Bitboard of X's pieces.
+     * @param boardO Bitboard of O's pieces.
+     * @return The cell index (5 * r + c) to play, or -1 if the position is not in the book.
+     */
+    int probe(uint32_t boardX, uint32_t boardO) const;
+
+    /**
+     * @brief Number of positions in the book.
+     */
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Compute the canonical key of a position over the 8 board symmetries.
+     * @param boardX Bitboard of X's pieces.
+     * @param boardO Bitboard of O's pieces.
+     * @param transform Receives the symmetry that maps the position onto its canonical form.
+     * @return The smallest key (X | O << 25) among the 8 transformed positions.
+     */
+    static uint64_t canonical(uint32_t boardX, uint32_t boardO, int& transform);
+
+    /**
+     * @brief Apply one of the 8 board symmetries to a bitboard.
+     * @param bits The bitboard to transform.
+     * @param transform The symmetry (0 = identity, 1-3 = rotations, 4-7 = reflections).
+     * @return The transformed bitboard.
+     */
+    static uint32_t transformBits(uint32_t bits, int transform);
+
+    /**
+     * @brief Map a cell through one of the 8 board symmetries.
+     * @param idx The cell index (5 * r + c).
+     * @param transform The symmetry to apply.
+     * @param inverse True to apply the inverse symmetry.
+     * @return The image cell index.
+     */
+    static int transformCell(int idx, int transform, bool inverse = false);
+
+private:
+    std::vector<uint64_t> entries;              ///< Sorted book entries (key << 5 | move).
+};
+
+
 /**
  * @brief User Interface and AI logic for the 5x5 Large Tic-Tac-Toe Game.
  * * This class handles player input, displays the board, and implements the
@@ -166,28 +325,43 @@ public:
 
     // --- 3. AI Core Functions ---
     /**
-     * @brief Determines the best move using a hybrid approach of Neural Network pruning and Minimax search.
+     * @brief Orders the moves of a search node in place, best first.
+     * * Receives the board, the side to move, the remaining depth and an output
+     * array of 25 cells; returns how many moves it wrote.
+     */
+    using MoveOrderer = std::function<int(Large_XO_Board* board, char side, int depth, int* moves)>;
+
+    /**
+     * @brief Determines the best move using Neural Network root pruning and a PVS search.
      * * @param player The AI player making the move.
-     * @param NN The specific Neural Network (X or O) to use for heuristic evaluation.
-     * @param depth The maximum depth to search in the minimax tree.
+     * @param depth The maximum depth to search.
      * @return A pair of integers {row, col} representing the optimal move.
      */
-    std::pair<int,int> bestMove(Player<char>* player, std::shared_ptr<NeuralNetwork>& NN, int depth);
+    std::pair<int,int> bestMove(Player<char>* player, int depth);
 
     /**
-     * @brief Implements the Minimax search algorithm with Alpha-Beta pruning.
-     * * @param board The current state of the board.
-     * @param NN The Neural Network to be used for evaluating non-terminal nodes (heuristic).
-     * @param maximize True if it's the maximizing player's (AI's) turn, false otherwise.
+     * @brief Iterative-deepening principal variation search from the given position.
+     * * Each iteration searches an aspiration window around the previous iteration's
+     * score and re-searches with an open bound when the result falls outside it.
+     * @param board The position to search (restored before returning).
+     * @param side The symbol of the side to move.
+     * @param depth The final search depth.
+     * @return A pair {cell index (5 * r + c), score for side}.
+     */
+    std::pair<int, float> search(Large_XO_Board* board, char side, int depth);
+
+    /**
+     * @brief Principal variation search in negamax form.
+     * * The first move is searched with the full window, the rest with a null
+     * window around alpha and re-searched only when they beat it.
+     * @param board The current state of the board.
+     * @param side The symbol of the side to move.
      * @param depth The current remaining depth of the search.
      * @param alpha The alpha value for pruning.
      * @param beta The beta value for pruning.
-     * @param ai The symbol of the AI player.
-     * @param opp The symbol of the opponent player.
-     * @return The calculated minimax value of the current board state.
+     * @return The value of the position for the side to move.
      */
-    float minimax(Large_XO_Board* board, std::shared_ptr<NeuralNetwork>& NN, bool maximize, int depth, float alpha, float beta,
-                  char ai, char opp);
+    float pvs(Large_XO_Board* board, char side, int depth, float alpha, float beta);
 
     /**
      * @brief Evaluates the current board state for the AI.
@@ -200,11 +374,68 @@ public:
      */
     float evaluate (Large_XO_Board* board, std::shared_ptr<NeuralNetwork>& NN, char ai, char opp);
 
+    /**
+     * @brief Set the number of empty cells at or below which the exact endgame solver is used.
+     * @param empties Empty-cell threshold (0 disables the solver).
+     */
+    void setEndgameThreshold(int empties);
+
+    /**
+     * @brief Replace the move orderer used at interior nodes (NN/killer/history by default).
+     * @param orderer The new orderer.
+     */
+    void setMoveOrderer(MoveOrderer orderer);
+
+    /**
+     * @brief Number of opening positions in the loaded book (0 if book.bin is missing).
+     */
+    size_t bookSize() const { return book.size(); }
 
 private:
+    /**
+     * @brief Generate the moves of a node from the empty-cell bits and order them best first.
+     * * Uses the Neural Network at deep nodes (depth >= nnOrderDepth) and the
+     * killer/history tables everywhere else.
+     * @param board The current state of the board.
+     * @param NN The Neural Network used for deep-node ordering.
+     * @param side The symbol of the side to move.
+     * @param depth The remaining search depth of the node.
+     * @param moves Output array (size 25) of cell indices, best first.
+     * @return The number of moves written.
+     */
+    int orderMoves(Large_XO_Board* board, std::shared_ptr<NeuralNetwork>& NN, char side, int depth, int* moves);
+
+    /**
+     * @brief Record a cutoff move in the killer and history tables.
+     * @param board The board at the node where the cutoff happened.
+     * @param side The symbol of the side that played the move.
+     * @param idx The cell index (5 * r + c) of the cutoff move.
+     * @param depth The remaining search depth of the node.
+     */
+    void recordCutoff(Large_XO_Board* board, char side, int idx, int depth);
+
+    /**
+     * @brief Sort moves in place by descending key (insertion sort, no allocation).
+     */
+    static void sortMoves(int* moves, double* keys, int count);
+
+    /**
+     * @brief Return the Neural Network trained for the given side.
+     */
+    std::shared_ptr<NeuralNetwork>& networkFor(char side);
+
     std::shared_ptr<NeuralNetwork> NNX;                              ///< Neural Network trained for Player X.
     std::shared_ptr<NeuralNetwork> NNO;                              ///< Neural Network trained for Player O.
     Large_XO_Board * board = nullptr;                                ///< Saved Board for display.
+    Large_XO_Endgame endgame;                                        ///< Exact solver for the last moves.
+    int endgameEmpties = 12;                                         ///< Empty cells at which the solver takes over.
+    Large_XO_Book book;                                              ///< Opening book, probed before any search.
+    int nnOrderDepth = 3;                                            ///< Minimum remaining depth for NN move ordering.
+    int rootCandidates = 8;                                          ///< Root moves kept after NN ranking.
+    float aspirationWindow = 0.5f;                                   ///< Half-width of the aspiration window.
+    MoveOrderer orderer;                                             ///< Move orderer used at interior nodes.
+    int killers[25][2];                                              ///< Two killer moves per move number (-1 if none).
+    int history[2][25] {};                                           ///< History heuristic per side (X, O) and cell.
 };
 
 #endif // Large_Tic_Tac_Toe_H
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * @file Large_XO_BookBuilder.cpp
+ * @brief Offline generator of the 5x5 XO opening book (book.bin).
+ *
+ * Enumerates every position of the first N plies, keeping one representative
+ * per symmetry class, deep-searches each of them in parallel with Large_XO_UI's
+ * search and writes the chosen moves as a sorted Large_XO_Book file.
+ *
+ * Usage: BookBuilder [plies = 4] [depth = 6] [threads = all cores] [output = book.bin]
+ * Run it from the directory holding netX.bin and netO.bin.
+ */
+
+#include "Large_Tic_Tac_Toe.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    int plies   = argc > 1 ? std::stoi(argv[1]) : 4;
+    int depth   = argc > 2 ? std::stoi(argv[2]) : 6;
+    int threads = argc > 3 ? std::stoi(argv[3]) : (int)std::max(1u, std::thread::hardware_concurrency());
+    std::string output = argc > 4 ? argv[4] : "book.bin";
+
+    // --- 1. Enumerate the canonical positions of plies 0 .. plies-1 ---
+    std::vector<uint64_t> positions;
+    std::set<uint64_t> layer = {0};
+
+    for (int ply = 0; ply < plies; ++ply) {
+        positions.insert(positions.end(), layer.begin(), layer.end());
+
+        std::set<uint64_t> next;
+        for (uint64_t key : layer) {
+            uint32_t boardX = key & 0x1FFFFFF;
+            uint32_t boardO = key >> 25;
+            bool xToMove = (ply % 2 == 0);
+            int transform;
+
+            for (uint32_t empty = ~(boardX | boardO) & 0x1FFFFFF; empty; empty &= empty - 1) {
+                uint32_t bit = empty & (0u - empty);
+                next.insert(xToMove ? Large_XO_Book::canonical(boardX | bit, boardO, transform)
+                                    : Large_XO_Book::canonical(boardX, boardO | bit, transform));
+            }
+        }
+        layer.swap(next);
+    }
+
+    std::cout << positions.size() << " positions up to ply " << plies
+              << ", depth " << depth << ", " << threads << " threads\n";
+
+    // --- 2. Search them in parallel, one UI (networks, killers, history) per thread ---
+    Large_XO_Board init;   // Builds the shared line tables before any thread starts
+
+    std::vector<std::unique_ptr<Large_XO_UI>> engines;
+    for (int t = 0; t < threads; ++t)
+        engines.push_back(std::make_unique<Large_XO_UI>());
+
+    std::vector<uint64_t> entries(positions.size());
+    std::atomic<size_t> nextPosition{0};
+    std::mutex printLock;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&](Large_XO_UI* ui) {
+        for (size_t i; (i = nextPosition++) < positions.size(); ) {
+            uint64_t key = positions[i];
+            Large_XO_Board board;
+
+            for (uint32_t bits = key & 0x1FFFFFF; bits; bits &= bits - 1)
+                board.updateCell(__builtin_ctz(bits) / 5, __builtin_ctz(bits) % 5, 'X');
+            for (uint32_t bits = key >> 25; bits; bits &= bits - 1)
+                board.updateCell(__builtin_ctz(bits) / 5, __builtin_ctz(bits) % 5, 'O');
+
+            char side = (board.getMoveCount() % 2 == 0) ? 'X' : 'O';
+            int move = ui->search(&board, side, depth).first;
+
+            // The position was set up in its canonical orientation, so the move already is too
+            entries[i] = (key << 5) | static_cast<uint64_t>(move);
+
+            if ((i + 1) % 100 == 0) {
+                std::lock_guard<std::mutex> lock(printLock);
+                std::cout << "  " << i + 1 << " / " << positions.size() << "\n";
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (auto& engine : engines)
+        pool.emplace_back(worker, engine.get());
+    for (auto& t : pool)
+        t.join();
+
+    // --- 3. Write the sorted book ---
+    if (!Large_XO_Book::save(output, entries)) {
+        std::cerr << "Failed to write " << output << "\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << entries.size() << " entries to " << output
+              << " in " << seconds << " s\n";
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include <iomanip>
 #include <cctype>
 #include "Memory_Tic_Tac_Toe.h"
+#include "../../header/Random.h"
 
 using namespace std;
 
@@ -175,6 +176,18 @@ bool Memory_Board::game_is_over(Player<char>* player)
     return is_win(player) || is_draw(player) || is_lose(player);
 }
 
+/**
+ * @brief Creates a copy of the board.
+ *
+ * Used by the tablebase to branch on moves without touching the live board.
+ *
+ * @return A new Memory_Board with the same cells and move count.
+ */
+Board<char>* Memory_Board::clone() const
+{
+    return new Memory_Board(*this);
+}
+
 //--------------------------------------- Memory_UI Implementation
 
 /**
@@ -210,14 +223,25 @@ Move<char>* Memory_UI::get_move(Player<char>* player)
     }
     else if (player->get_type() == PlayerType::COMPUTER)
     {
-        r = rand() % 3;
-        c = rand() % 3;
+        r = Random::local().below(3);
+        c = Random::local().below(3);
     }
     else if (player->get_type() == PlayerType::AI)
     {
-        auto move = bestMove(player, 9);
-        r = move.first;
-        c = move.second;
+        // Every reachable position is solved; search only if the table lacks this one
+        Tablebase<char>::Record solved;
+        bool known = tablebase().probe(player->get_board_ptr(), player->get_symbol(), solved);
+        if (known && solved.x >= 0)
+        {
+            r = solved.x;
+            c = solved.y;
+        }
+        else
+        {
+            auto move = bestMove(player, 9);
+            r = move.first;
+            c = move.second;
+        }
     }
 
     return new Move<char>(r, c, player->get_symbol());
@@ -253,4 +277,32 @@ void Memory_UI::display_board_matrix(const vector<vector<char>>& matrix) const
         cout << "\n   " << string((cell_width + 2) * cols, '-') << "\n";
     }
     cout << endl;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Returns the solved table of the variant.
+ *
+ * Built once, on first use, by walking every game from the empty board with
+ * X to move; the hidden display does not change the rules, so the values are
+ * those of standard Tic-Tac-Toe.
+ *
+ * @return The tablebase shared by all Memory UIs.
+ */
+const Tablebase<char>& Memory_UI::tablebase()
+{
+    static Tablebase<char> table = []
+    {
+        Tablebase<char> t('X', 'O', [](Board<char>* board, char symbol, vector<Move<char>>& moves)
+        {
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 3; ++c)
+                    if (board->get_cell(r, c) == '.')
+                        moves.emplace_back(r, c, symbol);
+        }, Tablebase<char>::square_base3<3>('.', 'X', 'O'),
+           Tablebase<char>::square_cells<3>());
+        Memory_Board start;
+        t.build(&start, 'X');
+        return t;
+    }();
+    return table;
+}
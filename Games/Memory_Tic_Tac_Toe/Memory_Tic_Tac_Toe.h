@@ -18,6 +18,7 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
 #include "../../header/Custom_UI.h"
+#include "../../header/Tablebase.h"
 
 using namespace std;
 
@@ -76,6 +77,12 @@ public:
      * @return true if the game has reached a terminal state
      */
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Creates a copy of the board (used by searches and the tablebase).
+     * @return A new Memory_Board with the same cells
+     */
+    Board<char>* clone() const override;
 };
 
 /**
@@ -114,6 +121,12 @@ public:
      * @param matrix Two-dimensional grid of board characters
      */
     void display_board_matrix(const vector<vector<char>>& matrix) const override;
+
+    /**
+     * @brief The solved table of the variant, built on first use (X moves first).
+     * @return The tablebase shared by all Memory UIs
+     */
+    static const Tablebase<char>& tablebase();
 };
 
 #endif // MEMORY_TIC_TAC_TOE_H
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Obstacles_Tic_Tac_Toe.h"
+#include <chrono>
+#include <thread>
 
 /// Initialize static array of winning 4-in-a-row masks.
 uint64_t Obstacles_Board::win4Masks[54] {};
@@ -168,12 +170,14 @@ int Obstacles_Board::getMoveCount()
  * 
  * Special behavior:
  *  - After a successful move, two new random traps are added.
+ *  - Clearing a cell takes back the move played there together with
+ *    the traps that move added, and nothing else.
  */
 bool Obstacles_Board::updateCell(size_t r, size_t c, char s)
 {
     size_t idx = r * 6 + c;
 
-    if (idx >= 36) return false;
+    if (r >= 6 || c >= 6) return false;
 
     uint64_t occupied = boardX | boardO | boardTraps;
 
@@ -181,38 +185,110 @@ bool Obstacles_Board::updateCell(size_t r, size_t c, char s)
     if (s != 0 && (occupied & (1ULL << idx)))
         return false;
 
-    // Clearing a cell
+    // Clearing a cell: find the move played there
     if (s == 0)
     {
-        uint64_t mask = ~(1ULL << idx);
-        boardX     &= mask;
-        boardO     &= mask;
-        boardTraps &= mask;
+        for (size_t i = history.size(); i-- > 0; )
+        {
+            if (history[i].cell != idx) continue;
+
+            uint64_t mask = ~((1ULL << idx) | history[i].traps);
+            boardX     &= mask;
+            boardO     &= mask;
+            boardTraps &= mask;
 
-        --nMoves;
-        return true;
+            history.erase(history.begin() + i);
+            --nMoves;
+            return true;
+        }
+        return false;
     }
 
-    // Placing X or O
+    // Place the stone, then 2 new random traps
+    play(idx, s, 0);
+    uint64_t traps = drawTraps();
+    boardTraps |= traps;
+    history.back().traps = traps;
+
+    return true;
+}
+
+
+/* ============================================================
+    play() / undo()
+   ============================================================ */
+/**
+ * @brief Places a stone with a known set of traps (no randomness).
+ */
+void Obstacles_Board::play(size_t idx, char s, uint64_t traps)
+{
     if (s == 'X') boardX |= (1ULL << idx);
     else          boardO |= (1ULL << idx);
 
+    boardTraps |= traps;
+    history.push_back({idx, traps});
     ++nMoves;
+}
+
+/**
+ * @brief Removes the last stone and exactly the traps it brought.
+ */
+void Obstacles_Board::undo()
+{
+    if (history.empty()) return;
+
+    Step last = history.back();
+    history.pop_back();
 
-    // Add 2 new random traps
+    uint64_t mask = ~(1ULL << last.cell);
+    boardX &= mask;
+    boardO &= mask;
+    boardTraps &= ~last.traps;
+    --nMoves;
+}
+
+
+/* ============================================================
+    drawTraps()
+   ============================================================ */
+/**
+ * @brief Chooses two distinct free cells uniformly at random.
+ */
+uint64_t Obstacles_Board::drawTraps(Random& rng)
+{
     auto avail = getAvailableMove();
-    if (avail.size() >= 2)
-    {
-        size_t i1 = avail[rand() % avail.size()];
-        boardTraps |= (1ULL << i1);
+    if (avail.size() < 2) return 0;
 
-        avail.erase(std::find(avail.begin(), avail.end(), i1));
+    size_t i1 = rng.below(avail.size());
+    size_t i2 = rng.below(avail.size() - 1);
+    if (i2 >= i1) ++i2;                 // Skip the first pick
 
-        size_t i2 = avail[rand() % avail.size()];
-        boardTraps |= (1ULL << i2);
-    }
+    return (1ULL << avail[i1]) | (1ULL << avail[i2]);
+}
 
-    return true;
+
+/* ============================================================
+    hasFour()
+   ============================================================ */
+/**
+ * @brief Four in a row by shifting the board onto itself.
+ *
+ * A run starting at bit i in direction d leaves bit i set in
+ * b & b>>d & b>>2d & b>>3d. Starts that would wrap into the next
+ * row are masked off; vertical runs cannot wrap.
+ */
+bool Obstacles_Board::hasFour(uint64_t bits)
+{
+    static const uint64_t LEFT  = 0x1C71C71C7ULL;   // Columns 0-2
+    static const uint64_t RIGHT = 0xE38E38E38ULL;   // Columns 3-5
+
+    uint64_t h = bits & (bits >> 1);
+    uint64_t v = bits & (bits >> 6);
+    uint64_t d = bits & (bits >> 7);
+    uint64_t a = bits & (bits >> 5);
+
+    return ((h & (h >> 2)) & LEFT) || (v & (v >> 12)) ||
+           ((d & (d >> 14)) & LEFT) || ((a & (a >> 10)) & RIGHT);
 }
 
 
@@ -241,18 +317,11 @@ bool Obstacles_Board::game_is_over(Player<char>* player)
     is_win()
    ============================================================ */
 /**
- * @brief Checks if player's bitboard matches any win mask.
+ * @brief Checks if player's bitboard holds four in a row.
  */
 bool Obstacles_Board::is_win(Player<char>* player)
 {
-    uint64_t boardTemp = (player->get_symbol() == 'X' ? boardX : boardO);
-
-    for (uint64_t mask : win4Masks)
-    {
-        if ((boardTemp & mask) == mask)
-            return true;
-    }
-    return false;
+    return hasFour(player->get_symbol() == 'X' ? boardX : boardO);
 }
 
 
@@ -264,14 +333,7 @@ bool Obstacles_Board::is_win(Player<char>* player)
  */
 bool Obstacles_Board::is_lose(Player<char>* player)
 {
-    uint64_t boardTemp = (player->get_symbol() == 'X' ? boardO : boardX);
-
-    for (uint64_t mask : win4Masks)
-    {
-        if ((boardTemp & mask) == mask)
-            return true;
-    }
-    return false;
+    return hasFour(player->get_symbol() == 'X' ? boardO : boardX);
 }
 
 
@@ -279,13 +341,168 @@ bool Obstacles_Board::is_lose(Player<char>* player)
     is_draw()
    ============================================================ */
 /**
- * @brief Draw occurs if board is full and no one wins.
+ * @brief Draw occurs if no free cell is left and no one wins.
+ *
+ * Traps take cells too, so the board usually fills up long
+ * before 36 moves have been played.
  */
 bool Obstacles_Board::is_draw(Player<char>* player)
 {
     return !is_win(player) &&
            !is_lose(player) &&
-           nMoves == 36;
+           (boardX | boardO | boardTraps) == FULL;
+}
+
+
+/* ============================================================
+    Obstacles_Engine
+   ============================================================ */
+
+/// Index of the n-th set bit of b (n counts from 0).
+static int nth_bit(uint64_t b, int n)
+{
+    while (n-- > 0) b &= b - 1;
+    return __builtin_ctzll(b);
+}
+
+Obstacles_Engine::Obstacles_Engine(int samples, int threads)
+    : samples(std::max(1, samples)),
+      threads(threads > 0 ? threads : (int)std::max(1u, std::thread::hardware_concurrency()))
+{}
+
+bool Obstacles_Engine::out_of_time(Worker& w)
+{
+    if ((++w.nodes & 1023) == 0 && chrono::steady_clock::now() >= deadline) stopped = true;
+    return stopped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Iterative deepening over the root moves, shared out between threads.
+ *
+ * An immediate win is played without searching. Each depth is a fresh
+ * sweep over the root moves; a depth cut short by the clock is dropped.
+ */
+int Obstacles_Engine::best_move(const Obstacles_Board* board, char toMove, int timeLimitMs)
+{
+    uint64_t own = board->getBits(toMove);
+    uint64_t opp = board->getBits(toMove == 'X' ? 'O' : 'X');
+    uint64_t traps = board->getTraps();
+    uint64_t free = ~(own | opp | traps) & Obstacles_Board::FULL;
+    if (free == 0) return -1;
+
+    std::vector<int> moves;
+    for (uint64_t f = free; f; f &= f - 1)
+    {
+        int cell = __builtin_ctzll(f);
+        if (Obstacles_Board::hasFour(own | (1ULL << cell))) return cell;
+        moves.push_back(cell);
+    }
+
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(timeLimitMs);
+    stopped = false;
+    depth = 0;
+
+    int best = moves[0];
+    std::vector<int> values(moves.size());
+    Random& seeder = Random::local();
+
+    for (int d = 1; d <= (int)moves.size(); ++d)
+    {
+        std::atomic<size_t> next{0};
+        auto work = [&](uint64_t seed)
+        {
+            Worker w;
+            w.rng.reseed(seed);
+            for (size_t i; !stopped && (i = next.fetch_add(1)) < moves.size(); )
+                values[i] = chance_node(own | (1ULL << moves[i]), opp, traps, d, 1, w);
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(work, seeder.next());
+        work(seeder.next());
+        for (auto& th : pool) th.join();
+
+        if (stopped) break;   // An unfinished iteration is not trusted
+
+        size_t top = std::max_element(values.begin(), values.end()) - values.begin();
+        best = moves[top];
+        depth = d;
+        if (values[top] > WIN - 64) break;    // Wins whatever the traps do
+    }
+    return best;
+}
+
+/**
+ * @brief Player node: an immediate win ends the search, otherwise the best
+ *        chance node over all free cells.
+ */
+int Obstacles_Engine::player_node(uint64_t own, uint64_t opp, uint64_t traps, int depth, int ply, Worker& w)
+{
+    if (out_of_time(w)) return 0;
+
+    uint64_t free = ~(own | opp | traps) & Obstacles_Board::FULL;
+    if (free == 0) return 0;    // Board filled: draw
+
+    for (uint64_t f = free; f; f &= f - 1)
+        if (Obstacles_Board::hasFour(own | (f & -f))) return WIN - ply;
+
+    if (depth == 0) return evaluate(own, opp, traps);
+
+    int best = -WIN * 2;
+    for (uint64_t f = free; f; f &= f - 1)
+        best = std::max(best, chance_node(own | (f & -f), opp, traps, depth, ply, w));
+    return best;
+}
+
+/**
+ * @brief Chance node: averages the opponent's replies over the trap pairs,
+ *        all of them when there are at most `samples`, a sample otherwise.
+ */
+int Obstacles_Engine::chance_node(uint64_t own, uint64_t opp, uint64_t traps, int depth, int ply, Worker& w)
+{
+    uint64_t free = ~(own | opp | traps) & Obstacles_Board::FULL;
+    int k = __builtin_popcountll(free);
+
+    // Fewer than two free cells: no traps are placed
+    if (k < 2) return -player_node(opp, own, traps, depth - 1, ply + 1, w);
+
+    long long total = 0;
+    int pairs = k * (k - 1) / 2;
+
+    if (pairs <= samples)
+    {
+        for (uint64_t a = free; a; a &= a - 1)
+            for (uint64_t b = a & (a - 1); b; b &= b - 1)
+                total -= player_node(opp, own, traps | (a & -a) | (b & -b), depth - 1, ply + 1, w);
+        return int(total / pairs);
+    }
+
+    for (int s = 0; s < samples; ++s)
+    {
+        int i1 = int(w.rng.below(k));
+        int i2 = int(w.rng.below(k - 1));
+        if (i2 >= i1) ++i2;     // Two distinct cells, uniformly
+        uint64_t pair = (1ULL << nth_bit(free, i1)) | (1ULL << nth_bit(free, i2));
+        total -= player_node(opp, own, traps | pair, depth - 1, ply + 1, w);
+    }
+    return int(total / samples);
+}
+
+/**
+ * @brief Counts the 4-windows each side can still fill (no opposing stone,
+ *        no trap), weighted steeply by how many stones are already in them.
+ */
+int Obstacles_Engine::evaluate(uint64_t own, uint64_t opp, uint64_t traps)
+{
+    static const int WEIGHT[5] = {0, 1, 6, 30, 0};
+
+    int score = 0;
+    for (uint64_t mask : Obstacles_Board::win4Masks)
+    {
+        if ((mask & (opp | traps)) == 0) score += WEIGHT[__builtin_popcountll(mask & own)];
+        if ((mask & (own | traps)) == 0) score -= WEIGHT[__builtin_popcountll(mask & opp)];
+    }
+    return score;
 }
 
 
@@ -310,7 +527,7 @@ Obstacles_UI::Obstacles_UI()
  *   Prompts for input.
  *
  * Computer:
- *   Selects a random available move.
+ *   Runs the expectimax engine for the time budget.
  */
 Move<char>* Obstacles_UI::get_move(Player<char>* player)
 {
@@ -327,8 +544,7 @@ Move<char>* Obstacles_UI::get_move(Player<char>* player)
     }
     else if(player->get_type() == PlayerType::COMPUTER)
     {
-        auto avail = board->getAvailableMove();
-        size_t idx = avail[rand() % avail.size()];
+        int idx = engine.best_move(board, player->get_symbol(), timeLimitMs);
         r = idx / 6;
         c = idx % 6;
     }
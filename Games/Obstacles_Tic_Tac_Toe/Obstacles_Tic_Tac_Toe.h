@@ -3,8 +3,12 @@
 
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/Custom_UI.h"
+#include "../../header/Random.h"
 #include <cstdint>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
 
 /**
  * @class Obstachles_Board
@@ -20,6 +24,7 @@
  * - Tracks occupied positions via bitboards rather than 2D arrays.
  * - Provides win/lose/draw logic based on 4-in-a-row masks.
  * - Provides list of legal moves as indices in range [0..63].
+ * - Records the traps each move added, so undo takes back exactly those.
  */
 class Obstacles_Board : public Board<char>
 {
@@ -81,6 +86,55 @@ public:
      */
     bool updateCell(size_t r, size_t c, char s);
 
+    /**
+     * @brief Places a stone and the traps that follow it, recording both for undo().
+     *
+     * @param idx Cell index (row * 6 + col); must be free.
+     * @param s Symbol ('X' or 'O').
+     * @param traps Trap bits added after the move (free cells other than idx).
+     */
+    void play(size_t idx, char s, uint64_t traps);
+
+    /**
+     * @brief Takes back the last play(): the stone and its traps together.
+     */
+    void undo();
+
+    /**
+     * @brief Picks the traps that follow a move: two free cells chosen at random.
+     *
+     * @param rng Generator to draw from (the calling thread's by default).
+     * @return Trap bits, or 0 if fewer than two cells are free.
+     */
+    uint64_t drawTraps(Random& rng = Random::local());
+
+    /**
+     * @brief Returns the bitboard of a player's stones.
+     *
+     * @param s Symbol ('X' or 'O').
+     */
+    uint64_t getBits(char s) const { return s == 'X' ? boardX : boardO; }
+
+    /**
+     * @brief Returns the bitboard of the traps.
+     */
+    uint64_t getTraps() const { return boardTraps; }
+
+    /**
+     * @brief Checks a bitboard for four in a row in any direction.
+     *
+     * Shifts the board onto itself once per direction instead of testing the
+     * 54 win masks one by one.
+     *
+     * @param bits The stones to check.
+     * @return True if the stones hold a 4-in-a-row.
+     */
+    static bool hasFour(uint64_t bits);
+
+    static const uint64_t FULL = (1ULL << 36) - 1;   ///> All 36 cells of the board.
+
+    static uint64_t win4Masks[54];        ///> Precomputed list of all 4-in-a-row winning masks.
+
     /**
      * @brief Applies a Move<char> object to the board.
      *
@@ -121,7 +175,7 @@ public:
     bool is_lose(Player<char>* player) override;
 
     /**
-     * @brief Checks for draw condition (board full and no winner).
+     * @brief Checks for draw condition (no free cell left and no winner).
      *
      * @param player Player to evaluate.
      * @return True if draw.
@@ -136,13 +190,111 @@ private:
 
     uint64_t boardTraps = 0;              ///> Bitboard representing traps/obstacles.
 
-    static uint64_t win4Masks[54];        ///> Precomputed list of all 4-in-a-row winning masks.
+    /**
+     * @brief One played move with the traps it added.
+     */
+    struct Step {
+        size_t cell;                      ///> Cell of the stone.
+        uint64_t traps;                   ///> Trap bits added after it.
+    };
+
+    std::vector<Step> history;            ///> Played moves, oldest first.
 
     char emptyCell;                       ///> Symbol used for empty cells.
 
     int nMoves = 0;                       ///> Counter of how many moves have been played.
 };
 
+/**
+ * @class Obstacles_Engine
+ * @brief Expectimax search for the computer player.
+ *
+ * Every move is followed by a chance node for the two traps it brings. When
+ * the free cells allow only a few trap pairs they are all enumerated and
+ * weighted equally; otherwise a fixed number of pairs is sampled. Player
+ * nodes take the best child, chance nodes the average.
+ *
+ * The search deepens one move at a time until the time budget runs out.
+ * The root moves of each depth are shared out between threads, each with its
+ * own sampler seeded from the caller's generator, and only fully searched
+ * depths are used.
+ */
+class Obstacles_Engine
+{
+public:
+    /**
+     * @brief Constructs the engine.
+     *
+     * @param samples Trap pairs tried at a chance node that has more than that many.
+     * @param threads Threads searching root moves (0 = one per hardware thread).
+     */
+    explicit Obstacles_Engine(int samples = 6, int threads = 0);
+
+    /**
+     * @brief Searches the position until the time budget runs out.
+     *
+     * @param board The live game board (left unchanged).
+     * @param toMove The symbol of the side to move.
+     * @param timeLimitMs Time budget in milliseconds.
+     * @return The chosen cell (row * 6 + col), or -1 if no cell is free.
+     */
+    int best_move(const Obstacles_Board* board, char toMove, int timeLimitMs);
+
+    /**
+     * @brief Returns the depth of the last fully searched iteration.
+     */
+    int get_depth() const { return depth; }
+
+private:
+    /**
+     * @brief Per-thread search state.
+     */
+    struct Worker {
+        Random rng;                       ///> Trap sampler.
+        long long nodes = 0;              ///> Nodes visited, for the time checks.
+    };
+
+    /**
+     * @brief Value of a position for the side to move.
+     *
+     * @param own Stones of the side to move.
+     * @param opp Stones of the other side.
+     * @param traps Trap bits.
+     * @param depth Moves left to search.
+     * @param ply Moves since the root (wins sooner score higher).
+     */
+    int player_node(uint64_t own, uint64_t opp, uint64_t traps, int depth, int ply, Worker& w);
+
+    /**
+     * @brief Expected value of a move for the player who made it, over the traps that follow.
+     *
+     * @param own Stones of the mover, the new stone included.
+     * @param opp Stones of the other side.
+     * @param traps Trap bits before the move.
+     */
+    int chance_node(uint64_t own, uint64_t opp, uint64_t traps, int depth, int ply, Worker& w);
+
+    /**
+     * @brief Static evaluation: open 4-windows of each side, weighted by their stones.
+     *
+     * @return Score for the side owning `own`.
+     */
+    static int evaluate(uint64_t own, uint64_t opp, uint64_t traps);
+
+    /**
+     * @brief Returns true once the time budget has run out (checked every few thousand nodes).
+     */
+    bool out_of_time(Worker& w);
+
+    static const int WIN = 10000;         ///> Base score of a win (minus the moves to reach it).
+
+    int samples;                          ///> Trap pairs sampled per chance node.
+    int threads;                          ///> Threads searching the root moves.
+    int depth = 0;                        ///> Depth of the last complete iteration.
+    std::chrono::steady_clock::time_point deadline;   ///> Time at which the search stops.
+    std::atomic<bool> stopped{false};     ///> Set once the time budget ran out.
+};
+
 /**
  * @class Obstachles_UI
  * @brief User interface handler for Obstacles Tic-Tac-Toe.
@@ -188,6 +340,10 @@ public:
 
 private:
     Obstacles_Board* board = nullptr;    ///> Pointer to the associated Obstachles_Board.
+
+    Obstacles_Engine engine;             ///> Search used by the computer player.
+
+    int timeLimitMs = 1000;              ///> Thinking time per computer move.
 };
 
 #endif // OBSTACLES_TIC_TAC_TOE_H
\ No newline at end of file
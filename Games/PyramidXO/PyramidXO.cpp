@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <algorithm>
+#include <thread>
 
 using namespace std;
 
@@ -23,12 +25,7 @@ bool PyramidXO_Board::update_board(Move<char>* move) {
     }
 
    
-    bool valid_shape = false;
-    if (x == 0 && y == 2) valid_shape = true;
-    else if (x == 1 && (y >= 1 && y <= 3)) valid_shape = true;
-    else if (x == 2 && (y >= 0 && y <= 4)) valid_shape = true;
-
-    if (!valid_shape) {
+    if (!is_valid_cell(x, y)) {
         return false;
     }
 
@@ -42,6 +39,15 @@ bool PyramidXO_Board::update_board(Move<char>* move) {
     return true;
 }
 
+bool PyramidXO_Board::is_valid_cell(int x, int y) {
+    // Row x of the pyramid spans columns 2 - x .. 2 + x
+    return x >= 0 && x < 3 && y >= 2 - x && y <= 2 + x;
+}
+
+Board<char>* PyramidXO_Board::clone() const {
+    return new PyramidXO_Board(*this);
+}
+
 bool PyramidXO_Board::is_win(Player<char>* player) {
     char s = player->get_symbol();
    
@@ -76,15 +82,52 @@ bool PyramidXO_Board::game_is_over(Player<char>* player) {
 }
 
 
-PyramidXO_UI::PyramidXO_UI() : UI<char>("Welcome to Pyramid XO Game", 3) {
+PyramidXO_UI::PyramidXO_UI()
+    : UI<char>("Welcome to Pyramid XO Game", 3),
+      mcts('X', 'O', [](Board<char>* board, char symbol, vector<Move<char>>& moves) {
+          for (int x = 0; x < 3; ++x)
+              for (int y = 2 - x; y <= 2 + x; ++y)
+                  if (board->get_cell(x, y) == 0) moves.emplace_back(x, y, symbol);
+      }) {
+    mcts.get_options().timeLimitMs = 500;
+    mcts.get_options().threads = std::max(1u, std::thread::hardware_concurrency());
 }
 
 Player<char>* PyramidXO_UI::create_player(string& name, char symbol, PlayerType type) {
     return new Player<char>(name, symbol, type);
 }
 
+const Tablebase<char>& PyramidXO_UI::tablebase() {
+    static Tablebase<char> table = [] {
+        Tablebase<char> t('X', 'O', [](Board<char>* board, char symbol, vector<Move<char>>& moves) {
+            for (int x = 0; x < 3; ++x)
+                for (int y = 2 - x; y <= 2 + x; ++y)
+                    if (board->get_cell(x, y) == 0) moves.emplace_back(x, y, symbol);
+        }, Tablebase<char>::base3(0, 'X', 'O'));
+        PyramidXO_Board start;
+        t.build(&start, 'X');
+        return t;
+    }();
+    return table;
+}
+
 Move<char>* PyramidXO_UI::get_move(Player<char>* player) {
     int x, y;
+    if (player->get_type() == PlayerType::COMPUTER) {
+        // Every reachable position is solved; search only if the table lacks this one
+        Tablebase<char>::Record solved;
+        bool known = tablebase().probe(player->get_board_ptr(), player->get_symbol(), solved);
+        if (known && solved.x >= 0) {
+            x = solved.x;
+            y = solved.y;
+        } else {
+            Move<char> m = mcts.search(player->get_board_ptr(), player->get_symbol());
+            x = m.get_x();
+            y = m.get_y();
+        }
+        cout << player->get_name() << " (" << player->get_symbol() << ") plays " << x << " " << y << "\n";
+        return new Move<char>(x, y, player->get_symbol());
+    }
     cout << player->get_name() << " (" << player->get_symbol() << "), enter your move (row col): ";
     cin >> x >> y;
     return new Move<char>(x, y, player->get_symbol());
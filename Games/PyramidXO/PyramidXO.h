@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../../header/BoardGame_Classes.h"
+#include "../../header/MCTS.h"
+#include "../../header/Tablebase.h"
 
 class PyramidXO_Board : public Board<char>
 {
@@ -16,11 +18,18 @@ public:
     bool is_draw(Player<char>* player) override;
 
     bool game_is_over(Player<char>* player) override;
+
+    Board<char>* clone() const override;
+
+    /** @brief True if (x, y) is one of the nine cells of the pyramid. */
+    static bool is_valid_cell(int x, int y);
 };
 
 
 class PyramidXO_UI : public UI<char>
 {
+    MCTS<char> mcts;    ///< Search used by the computer player when the tablebase has no answer.
+
 public:
     PyramidXO_UI();
     ~PyramidXO_UI() {}
@@ -30,4 +39,7 @@ public:
     Move<char>* get_move(Player<char>* player) override;
 
     void display_board_matrix(const std::vector<std::vector<char>>& matrix) const override;
+
+    /** @brief The solved Pyramid XO table, built on first use (X moves first). */
+    static const Tablebase<char>& tablebase();
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "SUS.h"
+#include "../../header/Symmetry.h"
 #include <iostream>
 
 SUS_Board::SUS_Board() : Board(3, 3)
@@ -8,24 +9,28 @@ SUS_Board::SUS_Board() : Board(3, 3)
         for (auto &cell : row)
             cell = blank_symbol;
 }
-void SUS_Board::score(int x, int y, char sym){
+int SUS_Board::sus_count(int x, int y) const{
+    int count = 0;
     // Check if there is S-U-S  in the row of the last move
     if (board[x][0]=='S'&&board[x][1]=='U'&&board[x][2]=='S'){
-        sym == 'S' ? s_score++ : u_score++;
+        count++;
     }
      // Check if there is S-U-S in the column of the last move
     if(board[0][y]=='S'&&board[1][y]=='U'&&board[2][y]=='S'){
-        sym == 'S' ? s_score++ : u_score++;
+        count++;
     }
      // Check if there is S-U-S in the diagonal + last move is in the diagonal
     if (board[0][0]=='S'&& board[1][1]=='U'&& board[2][2]=='S' &&(x==y) ){
-        sym == 'S' ? s_score++ : u_score++;
+        count++;
     }
     if (board[0][2]=='S'&& board[1][1]=='U' &&board[2][0]=='S' &&(x+y==2)){
-        sym == 'S' ? s_score++ : u_score++;
+        count++;
     }
-
-       
+    return count;
+}
+void SUS_Board::score(int x, int y, char sym){
+    // The letter just placed scores every S-U-S through it for its player
+    (sym == 'S' ? s_score : u_score) += sus_count(x, y);
  }
 bool SUS_Board::update_board(Move<char> *move)
 {
@@ -36,8 +41,11 @@ bool SUS_Board::update_board(Move<char> *move)
         (board[x][y] == blank_symbol || mark == 0))
     {
 
+       int old_s = s_score, old_u = u_score;
         if (mark == 0)
-        { // Undo move
+        { // Undo move: the letter's player gives back the points it scored
+            if (board[x][y] != blank_symbol)
+                (board[x][y] == 'S' ? s_score : u_score) -= sus_count(x, y);
             n_moves--;
             board[x][y] = blank_symbol;
         }
@@ -45,9 +53,11 @@ bool SUS_Board::update_board(Move<char> *move)
         { // Apply move
             n_moves++;
             board[x][y] = toupper(mark);
+            score(x,y,board[x][y]);
         }
-       score(x,y,mark);
-       cout<<"S score: "<<s_score<<endl <<"U score: "<< u_score;
+       // The UI shows the scores; it learns about changes from these events
+       if (s_score != old_s) notify_score_changed('S', s_score);
+       if (u_score != old_u) notify_score_changed('U', u_score);
 
         return true;
     }
@@ -102,6 +112,17 @@ Player<char> **SUS_UI::setup_players()
     return players;
 }
 
+void SUS_UI::on_score_changed(char symbol, int score)
+{
+    (symbol == 'S' ? s_score : u_score) = score;
+}
+
+void SUS_UI::display_board_matrix(const vector<vector<char>>& matrix) const
+{
+    UI<char>::display_board_matrix(matrix);
+    cout << "S score: " << s_score << endl << "U score: " << u_score << endl;
+}
+
 Player<char> *SUS_UI::create_player(string &name, char symbol, PlayerType type)
 {
     return new Player<char>(name, symbol, type);
@@ -119,136 +140,129 @@ Move<char> *SUS_UI::get_move(Player<char> *player)
         
     } 
     else if (player->get_type() == PlayerType::COMPUTER) {
-       AI=player->get_symbol();
-        if (AI=='X'){
-             OOP='O';
-        }
-        else if (AI=='O'){
-             OOP='X';
-        }
-       auto* b = dynamic_cast<SUS_Board*>(player->get_board_ptr());
-        SUS_UI::moove mov = SUS_UI::findBestMove(player,b->get_board_matrix());
-        x = mov.row, y = mov.col;
+        // Perfect play is a table lookup
+        int cell = SUS_Solver::best_move(player->get_board_ptr()->get_board_matrix());
+        x = cell / 3, y = cell % 3;
      } 
     return new Move<char>(x, y, player->get_symbol());
 }
 //=========================AI==========================
 
-int SUS_UI::evaluate(vector<vector<char>>& board, int lastRow, int lastCol, char lastPlayer)
+// The 8 lines; the middle cell of each must hold the U of an S-U-S.
+static const int SUS_LINES[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+    {0, 4, 8}, {2, 4, 6}
+};
+
+static const int POW3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+int8_t SUS_Solver::values[SUS_Solver::STATES];
+uint8_t SUS_Solver::moves[SUS_Solver::STATES];
+uint16_t SUS_Solver::base3[512];
+bool SUS_Solver::built = false;
+
+int SUS_Solver::canonical(uint32_t s, uint32_t u, int& transform)
 {
-  
-    int score = 0;
-    if (board[lastRow][0] == 'S' &&  board[lastRow][1] == 'U' &&  board[lastRow][2] == 'S'){
-            score += (lastPlayer == AI) ? 10 : -10;
-    }
-    
-    if (board[0][lastCol] == 'S' &&  board[1][lastCol] == 'U' && board[2][lastCol] == 'S'){
-            score += (lastPlayer == AI) ? 10 : -10;
-    }
-    
-    if(board[0][0]=='S'&&board[1][1]=='U'&&board[2][2]=='S'  &&(lastCol==lastRow)){
-        score += (lastPlayer == AI) ? 10 : -10;
+    uint64_t first = s, second = u;
+    transform = Symmetry<3>::canonical_pair(first, second);
+    return base3[first] + 2 * base3[second];
+}
+
+void SUS_Solver::encode(const vector<vector<char>>& board, uint32_t& s, uint32_t& u)
+{
+    s = u = 0;
+    for (int i = 0; i < 9; ++i) {
+        char c = board[i / 3][i % 3];
+        if (c == 'S') s |= 1u << i;
+        else if (c == 'U') u |= 1u << i;
     }
-    
-    
-    if(board[0][2]=='S'&& board[1][1]=='U' &&board[2][0]=='S' &&(lastCol+lastRow==2))
-        {
-            score += (lastPlayer == AI) ? 10 : -10;
-        }
-    
-    
-    return score;
 }
 
-bool SUS_UI::isMovesLeft(vector<vector<char>>& board)
+void SUS_Solver::build()
 {
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            if (board[i][j] == '.')
-                return true;
-    return false;
+    if (built) return;
+    for (auto& m : moves) m = 255;
+    for (int mask = 0; mask < 512; ++mask)
+        for (int i = 0; i < 9; ++i)
+            if (mask >> i & 1) base3[mask] += POW3[i];
+
+    int cells[9] = {};
+    solve(cells, 0);
+    built = true;
 }
 
-int SUS_UI::minimax(vector<vector<char>>& board, int depth, int alpha, int beta, bool isMax, int lastRow, int lastCol, char lastPlayer)
+int SUS_Solver::solve(int* cells, int filled)
 {
-    int score = evaluate(board, lastRow, lastCol, lastPlayer);
-    
-    if (score >= 10) {return score - depth;} 
-    if (score <= -10) {return score + depth;}
-    if (!isMovesLeft(board)) return 0;
-    if (isMax)
-    {
-        int best = INT_MIN;
-        for (int i = 0; i < 3; i++)
-        {
-            for (int j = 0; j < 3; j++)
-            {
-                if (board[i][j] == '.')
-                {
-                    board[i][j] = AI;
-                    best = max(best, minimax(board, depth+1, alpha, beta, false, i, j, AI));
-                    board[i][j] = '.';
-                    alpha = max(alpha, best);
-                    if (beta <= alpha) break;
-                }
-            }
-            if (beta <= alpha) break;
-        }
-        return best;
+    if (filled == 9) return 0;
+
+    uint32_t s = 0, u = 0;
+    for (int i = 0; i < 9; ++i) {
+        if (cells[i] == 1) s |= 1u << i;
+        else if (cells[i] == 2) u |= 1u << i;
     }
-    else
-    {
-        int best = INT_MAX;
-        for (int i = 0; i < 3; i++)
-        {
-            for (int j = 0; j < 3; j++)
-            {
-                if (board[i][j] == '.')
-                {
-                    board[i][j] = OOP;
-                    best = min(best, minimax(board, depth+1, alpha, beta, true, i, j, OOP));
-                    board[i][j] = '.';
-
-                    beta = min(beta, best);
-                    if (beta <= alpha) break;
-                }
-            }
-            if (beta <= alpha) break;
+    int transform;
+    int key = canonical(s, u, transform);
+    if (moves[key] != 255) return values[key];
+
+    // S moves first, so S is to move whenever an even number of cells is filled
+    int mark = (filled % 2 == 0) ? 1 : 2;
+    int sign = (mark == 1) ? 1 : -1;
+    int best = 0, bestCell = -1;
+
+    for (int c = 0; c < 9; ++c) {
+        if (cells[c]) continue;
+        cells[c] = mark;
+
+        // Points for the mover: S-U-S lines through the new letter
+        int gain = 0;
+        for (const auto& line : SUS_LINES)
+            if ((line[0] == c || line[1] == c || line[2] == c) &&
+                cells[line[0]] == 1 && cells[line[1]] == 2 && cells[line[2]] == 1)
+                ++gain;
+
+        int v = sign * gain + solve(cells, filled + 1);
+        cells[c] = 0;
+
+        // S maximises S-minus-U points, U minimises them
+        if (bestCell < 0 || sign * v > sign * best) {
+            best = v;
+            bestCell = c;
         }
-        return best;
     }
+
+    values[key] = int8_t(best);
+    moves[key] = uint8_t(Symmetry<3>::transform_cell(bestCell, transform));
+    return best;
 }
 
-SUS_UI::moove SUS_UI::findBestMove(Player<char>* player, vector<vector<char>> board)
+int SUS_Solver::best_move(const vector<vector<char>>& board)
 {
-    int bestVal = INT_MIN;
-    moove bestMove;
-    bestMove.row = -1;
-    bestMove.col = -1;
+    build();
+    uint32_t s, u;
+    encode(board, s, u);
+    int transform;
+    int key = canonical(s, u, transform);
 
-    int alpha = INT_MIN, beta = INT_MAX;
-
-    for (int i = 0; i < 3; i++)
-    {
-        for (int j = 0; j < 3; j++)
-        {
-            if (board[i][j] == '.')
-            {
-                board[i][j] = AI;
-                int moveVal = minimax(board, 0, alpha, beta, false, i, j, AI);
-                board[i][j] = '.';
-                
-                if (moveVal > bestVal)
-                {
-                    bestVal = moveVal;
-                    bestMove.row = i;
-                    bestMove.col = j;
-                }
-                
-                alpha = max(alpha, bestVal);
-            }
+    // A position the game cannot reach from an empty board is solved on demand
+    if (moves[key] == 255) {
+        int cells[9], filled = 0;
+        for (int i = 0; i < 9; ++i) {
+            cells[i] = (s >> i & 1) ? 1 : (u >> i & 1) ? 2 : 0;
+            filled += cells[i] != 0;
         }
+        if (filled == 9) return -1;
+        solve(cells, filled);
     }
+    return Symmetry<3>::transform_cell(moves[key], transform, true);
+}
 
-    return bestMove;
-}
\ No newline at end of file
+int SUS_Solver::value(const vector<vector<char>>& board)
+{
+    build();
+    uint32_t s, u;
+    encode(board, s, u);
+    int transform;
+    int key = canonical(s, u, transform);
+    return moves[key] == 255 ? 0 : values[key];
+}
@@ -1,6 +1,7 @@
 #ifndef SUS
 #define SUS
 #include "../../header/BoardGame_Classes.h"
+#include <cstdint>
 using namespace std;
 
 class SUS_Board: public Board<char>{
@@ -19,11 +20,73 @@ public:
   bool is_draw(Player<char>* player) override;
   bool game_is_over(Player<char>* player) override;
   void score(int x,int y, char sym);
+  /** @brief Number of S-U-S lines through cell (x, y). */
+  int sus_count(int x, int y) const;
 };
+/**
+ * @brief Perfect-play table for SUS.
+ *
+ * A position is the 3x3 grid of '.', 'S' and 'U' (S moves when both have
+ * placed the same number of letters), encoded in base 3 as sum(cell * 3^i)
+ * with '.' = 0, 'S' = 1, 'U' = 2. Points already scored do not change what is
+ * best from here on, so the table holds, per position, the S-minus-U points
+ * still to come under perfect play and a move reaching them.
+ *
+ * Every reachable position is solved once, on first use, and only its
+ * canonical form (the smallest image over the 8 board symmetries, see
+ * Symmetry.h) is stored; a lookup canonicalises the board and maps the
+ * stored move back.
+ */
+class SUS_Solver {
+public:
+    static const int STATES = 19683;    ///< 3^9 codes.
+
+    /**
+     * @brief Best cell for the side to move.
+     * @param board The 3x3 board matrix.
+     * @return The cell as 3 * row + col, or -1 on a full board.
+     */
+    static int best_move(const vector<vector<char>>& board);
+
+    /**
+     * @brief S points minus U points still to come under perfect play.
+     * @param board The 3x3 board matrix.
+     */
+    static int value(const vector<vector<char>>& board);
+
+    /**
+     * @brief Canonical code of a position: the code of its smallest symmetric image.
+     * @param s Bitboard of the S cells (bit 3 * row + col).
+     * @param u Bitboard of the U cells.
+     * @param transform Output: the symmetry mapping the position to the canonical one.
+     */
+    static int canonical(uint32_t s, uint32_t u, int& transform);
+
+private:
+    /** @brief Solve every position reachable from the empty board (once). */
+    static void build();
+
+    /**
+     * @brief Solve a position and the positions below it.
+     * @param cells Cell contents, 0 empty, 1 S, 2 U (restored on return).
+     * @param filled Number of occupied cells.
+     * @return S-minus-U points still to come.
+     */
+    static int solve(int* cells, int filled);
+
+    /** @brief S and U bitboards of a board matrix. */
+    static void encode(const vector<vector<char>>& board, uint32_t& s, uint32_t& u);
+
+    static int8_t values[STATES];       ///< Points to come, by canonical code.
+    static uint8_t moves[STATES];       ///< Best cell in canonical orientation, 255 if unsolved.
+    static uint16_t base3[512];         ///< Base-3 value of each 9-bit mask read as 0/1 digits.
+    static bool built;                  ///< build() has run.
+};
+
 class SUS_UI: public UI<char> {
 private:
- char OOP='U';
- char AI='S';
+ int s_score = 0;   ///< Latest S score, kept from board events.
+ int u_score = 0;   ///< Latest U score, kept from board events.
 
 public:
  SUS_UI();
@@ -31,15 +94,8 @@ public:
  Player<char>** setup_players() override;
  Player<char>* create_player(string& name, char symbol, PlayerType type) override;
  Move<char>* get_move(Player<char>* player) override;
- //=====For AI====
-    struct moove{ int row, col;};
-    bool isMovesLeft( vector<vector<char>>& matrix);
-    int evaluate( vector<vector<char>>& board, int lastRow, int lastCol, char lastPlayer);
-    int minimax( vector<vector<char>>& board, int depth, int alpha, int beta, bool isMax, int lastRow, int lastCol, char lastPlayer);
-    moove findBestMove(Player<char>* player, vector<vector<char>> board);
-
-
-
+ void display_board_matrix(const vector<vector<char>>& matrix) const override;
+ void on_score_changed(char symbol, int score) override;
 };
 
 #endif //SUS
@@ -1,8 +1,18 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype>
+#include <chrono>
 #include "Ultimate.h"
 
+uint8_t Ultimate_Board::line_table[512] {};
+
+// The eight three-in-a-row lines of a 3x3 board as 9-bit masks
+static const uint16_t LINES[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+
+// Zobrist keys: one per side and move, one per forced sub-board (index 0 = any)
+static uint64_t zobrist[2][81];
+static uint64_t zobrist_next[10];
+
 Ultimate_Board::Ultimate_Board() : Board(9, 9)
 {
     for (auto &row : board)
@@ -10,119 +20,145 @@ Ultimate_Board::Ultimate_Board() : Board(9, 9)
         for (auto &cell : row)
             cell = blank_symbol;
     }
-  
+
+    if (line_table[LINES[0]] == 0) {
+        for (int mask = 0; mask < 512; ++mask)
+            for (uint16_t line : LINES)
+                if ((mask & line) == line) line_table[mask] = 1;
+
+        // splitmix64 with a fixed seed: the keys only have to be distinct, not secret
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        auto next = [&seed]() {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        };
+        for (auto &side : zobrist)
+            for (auto &key : side) key = next();
+        for (auto &key : zobrist_next) key = next();
+    }
+    hash = zobrist_next[0];
 }
-void  Ultimate_Board::small_board_check(int x,int y, char sym){
- 
-    auto all_equal = [&](char a, char b, char c)
-    {
-        return a == b && b == c && a != blank_symbol;
-    };
-  
-         bool win = false;
-         bool full = true;
-         int row_start = (x / 3) * 3; 
-         int col_start = (y / 3) * 3;
-          // Check rows and columns
-        for (int i = 0; i < 3; ++i) {
-                if ((all_equal(board[row_start + i][col_start], board[row_start + i][col_start + 1], board[row_start + i][col_start + 2])&& board[row_start + i][col_start] == sym ) ||
-                    (all_equal(board[row_start][col_start + i], board[row_start + 1][col_start + i], board[row_start + 2][col_start + i])&& board[row_start][col_start + i] == sym))
-                {
-                    large_board[x/3][y/3] =sym;
-                    win = true;
-                }
-            }
-
-             // Check diagonals
-        if ((all_equal(board[row_start][col_start], board[row_start + 1][col_start + 1], board[row_start + 2][col_start + 2])&& board[row_start][col_start] == sym)||
-                (all_equal(board[row_start][col_start + 2], board[row_start + 1][col_start + 1], board[row_start + 2][col_start])&& board[row_start][col_start + 2] == sym)) {
-                large_board[x / 3][y/3] = sym;
-                win = true;
-            }
-
-            //check if draw
-        for (int i = 0; i < 3; ++i){
-            for (int j = 0; j < 3; ++j){
-                if (board[row_start + i][col_start + j] == blank_symbol){
-                        full = false;
-                    }
-                }
-            }
-
-          //if full and !win-->draw
-        if (full && !win)
-            {
-                large_board[x / 3][y / 3] = '#'; 
-            }
-        
+
+void Ultimate_Board::update_sub_board(int sub)
+{
+    uint16_t bit = 1 << sub;
+    won[0] &= ~bit;
+    won[1] &= ~bit;
+    drawn &= ~bit;
+
+    // No move can be played in a decided sub-board, so at most one side has a line
+    char result = blank_symbol;
+    if (line_table[cells[0][sub]]) { won[0] |= bit; result = 'X'; }
+    else if (line_table[cells[1][sub]]) { won[1] |= bit; result = 'O'; }
+    else if ((cells[0][sub] | cells[1][sub]) == FULL) { drawn |= bit; result = '#'; }
+
+    large_board[sub / 3][sub % 3] = result;
 }
+
 bool Ultimate_Board::all_small_boards_done() {
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (large_board[i][j] == blank_symbol)
-                return false;
-        }
+    return get_decided() == FULL;
+}
+
+int Ultimate_Board::legal_moves(int* moves) const
+{
+    uint16_t subs = next_board >= 0 ? (1 << next_board) : (FULL & ~get_decided());
+    int count = 0;
+
+    for (; subs; subs &= subs - 1) {
+        int sub = __builtin_ctz(subs);
+        for (uint16_t empty = FULL & ~(cells[0][sub] | cells[1][sub]); empty; empty &= empty - 1)
+            moves[count++] = 9 * sub + __builtin_ctz(empty);
     }
-    return true;
+    return count;
 }
+
+bool Ultimate_Board::can_play(int move) const
+{
+    if (move < 0 || move >= 81) return false;
+
+    int sub = move / 9, cell = move % 9;
+    if (next_board >= 0 && sub != next_board) return false;
+    if (get_decided() >> sub & 1) return false;
+
+    return !((cells[0][sub] | cells[1][sub]) >> cell & 1);
+}
+
+void Ultimate_Board::play(int move, char mark)
+{
+    int sub = move / 9, cell = move % 9;
+    int side = (mark == 'X') ? 0 : 1;
+
+    history.push_back({move, next_board});
+    hash ^= zobrist[side][move] ^ zobrist_next[next_board + 1];
+
+    cells[side][sub] |= 1 << cell;
+    update_sub_board(sub);
+
+    // Send the opponent to the sub-board matching the cell, unless it is already decided
+    next_board = (get_decided() >> cell & 1) ? -1 : cell;
+    hash ^= zobrist_next[next_board + 1];
+
+    board[move_x(move)][move_y(move)] = mark;
+    n_moves++;
+}
+
+void Ultimate_Board::undo()
+{
+    auto [move, previous] = history.back();
+    history.pop_back();
+
+    int sub = move / 9, cell = move % 9;
+    int side = (cells[0][sub] >> cell & 1) ? 0 : 1;
+
+    hash ^= zobrist_next[next_board + 1] ^ zobrist_next[previous + 1] ^ zobrist[side][move];
+    next_board = previous;
+
+    cells[side][sub] &= ~(1 << cell);
+    update_sub_board(sub);
+
+    board[move_x(move)][move_y(move)] = blank_symbol;
+    n_moves--;
+}
+
 bool Ultimate_Board::update_board(Move<char> *move)
 {
     int x = move->get_x();
     int y = move->get_y();
     char mark = move->get_symbol();
-    // Validate move and apply if valid
-    if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0) && large_board[x / 3][y / 3] == blank_symbol)
-    {
 
-        if (mark == 0)
-        { // Undo move
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else
-        { // Apply move
-            n_moves++;
-            board[x][y] = toupper(mark);
-        }
-         small_board_check(x,y,mark);
-         // These lines display the large board
-        // I think this logic should be moved to the UI class
-       cout << "\nLarge Board (3x3 of small boards results):\n";
-       for(int i=0;i<3;i++){
-          for(int j=0;j<3;j++){cout << setw(3) << large_board[i][j] << " ";}
-          cout << endl;
-       }
-        cout << endl;
-      return true;
-    }
+    if (x < 0 || x >= rows || y < 0 || y >= columns)
+        return false;
 
-    return false;
-}
-bool Ultimate_Board::is_win(Player<char> *player)
-{
+    if (mark == 0)
+    { // Undo move: only the last move can be taken back
+        if (history.empty() || history.back().first != to_move(x, y))
+            return false;
 
-    const char sym = player->get_symbol();
+        uint16_t decided = get_decided();
+        undo();
+        if (get_decided() != decided)
+            notify_sub_board_won(x / 3, y / 3, large_board[x / 3][y / 3]);
+        return true;
+    }
 
-    auto all_equal = [&](char a, char b, char c)
-    {
-        return a == b && b == c && a != blank_symbol && a!='T';
-    };
+    // Validate move (free cell, open sub-board, the sub-board we were sent to) and apply if valid
+    if (!can_play(to_move(x, y)))
+        return false;
 
-    // Check rows and columns
-    for (int i = 0; i <3; ++i)
-    {
-        if ((all_equal(large_board[i][0], large_board[i][1], large_board[i][2]) && large_board[i][0] == sym) ||
-            (all_equal(large_board[0][i], large_board[1][i], large_board[2][i]) && large_board[0][i] == sym))
-            return true;
-    }
+    uint16_t decided = get_decided();
+    play(to_move(x, y), toupper(mark));
 
-    // Check diagonals
-    if ((all_equal(large_board[0][0], large_board[1][1], large_board[2][2]) && large_board[1][1] == sym) ||
-        (all_equal(large_board[0][2], large_board[1][1], large_board[2][0]) && large_board[1][1] == sym))
-        return true;
+    // The large board is shown by the UI, which learns about decided sub-boards from this event
+    if (get_decided() != decided)
+        notify_sub_board_won(x / 3, y / 3, large_board[x / 3][y / 3]);
+    return true;
+}
 
-    return false;
+bool Ultimate_Board::is_win(Player<char> *player)
+{
+    return line_table[get_won(toupper(player->get_symbol()))];
 }
 
 bool Ultimate_Board::is_draw(Player<char> *player)
@@ -139,6 +175,11 @@ bool Ultimate_Board::game_is_over(Player<char> *player)
 //=====================UI===========
 Ultimate_UI::Ultimate_UI() : UI<char>("Ultimate Tic_Tac_TOe", 3) {}
 
+void Ultimate_UI::on_sub_board_won(int sub_row, int sub_col, char winner)
+{
+    large_board[sub_row][sub_col] = winner;
+}
+
 Player<char> *Ultimate_UI::create_player(string &name, char symbol, PlayerType type)
 {
     return new Player<char>(name, symbol, type);
@@ -166,7 +207,13 @@ void Ultimate_UI::display_board_matrix(const vector<vector<char>>& matrix) const
             
         }
         cout << endl;
-        
+
+        cout << "\nLarge Board (3x3 of small boards results):\n";
+        for(int i=0;i<3;i++){
+           for(int j=0;j<3;j++){cout << setw(3) << large_board[i][j] << " ";}
+           cout << endl;
+        }
+        cout << endl;
 
     }
 
@@ -176,13 +223,160 @@ Move<char> *Ultimate_UI::get_move(Player<char> *player)
 
     if (player->get_type() == PlayerType::HUMAN)
     {
+        auto* b = dynamic_cast<Ultimate_Board*>(player->get_board_ptr());
+        int sub = b->get_next_board();
+        if (sub >= 0)
+            cout << "\nYou are sent to the small board at rows " << 3 * (sub / 3) << "-" << 3 * (sub / 3) + 2
+                 << ", columns " << 3 * (sub % 3) << "-" << 3 * (sub % 3) + 2 << ".";
         cout << "\nPlease enter your move x and y (0 to 8): ";
         cin >> x >> y;
     }
     else if (player->get_type() == PlayerType::COMPUTER)
     {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        auto* b = dynamic_cast<Ultimate_Board*>(player->get_board_ptr());
+        int move = engine.best_move(b, toupper(player->get_symbol()), timeLimitMs);
+        x = Ultimate_Board::move_x(move);
+        y = Ultimate_Board::move_y(move);
     }
     return new Move<char>(x, y, player->get_symbol());
-}
\ No newline at end of file
+}
+//=====================AI===========
+
+Ultimate_Engine::Ultimate_Engine(int tableBits)
+    : table(size_t(1) << tableBits), tableMask((uint64_t(1) << tableBits) - 1)
+{
+}
+
+int Ultimate_Engine::best_move(Ultimate_Board* board, char toMove, int timeLimitMs, int maxDepth)
+{
+    this->board = board;
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(timeLimitMs);
+    nodes = 0;
+    stopped = false;
+
+    int moves[81];
+    int count = board->legal_moves(moves);
+    int best = moves[0];
+
+    int empties = 81 - board->get_moves();
+    for (int depth = 1; depth <= maxDepth && depth <= empties; ++depth) {
+        negamax(toMove, depth, -WIN, WIN);
+        if (stopped) break;   // An unfinished iteration is not trusted
+
+        const Entry& e = table[board->get_hash() & tableMask];
+        if (e.key == board->get_hash() && board->can_play(e.move)) best = e.move;
+
+        // Nothing left to decide when the only move is forced
+        if (count == 1) break;
+    }
+    return best;
+}
+
+int Ultimate_Engine::negamax(char side, int depth, int alpha, int beta)
+{
+    char other = (side == 'X') ? 'O' : 'X';
+
+    // The previous move may have ended the game
+    if (Ultimate_Board::line_table[board->get_won(other)])
+        return -(WIN - board->get_moves());
+
+    int moves[81];
+    int count = board->legal_moves(moves);
+    if (count == 0) return 0;
+    if (depth == 0) return evaluate(side);
+
+    if ((++nodes & 4095) == 0 && chrono::steady_clock::now() >= deadline) stopped = true;
+    if (stopped) return 0;
+
+    uint64_t key = board->get_hash();
+    Entry& slot = table[key & tableMask];
+    int ttMove = -1;
+
+    if (slot.key == key) {
+        ttMove = slot.move;
+        if (slot.depth >= depth) {
+            if (slot.bound == EXACT) return slot.value;
+            if (slot.bound == LOWER && slot.value >= beta) return slot.value;
+            if (slot.bound == UPPER && slot.value <= alpha) return slot.value;
+        }
+    }
+
+    // Order: TT move, moves that win a sub-board, quiet moves, then moves
+    // that hand the opponent a free choice of sub-board
+    int keys[81];
+    uint16_t decided = board->get_decided();
+    for (int i = 0; i < count; ++i) {
+        int sub = moves[i] / 9, cell = moves[i] % 9;
+        if (moves[i] == ttMove) keys[i] = 3;
+        else if (Ultimate_Board::line_table[board->get_cells(side, sub) | (1 << cell)]) keys[i] = 2;
+        else if (decided >> cell & 1) keys[i] = 0;
+        else keys[i] = 1;
+    }
+    for (int i = 1; i < count; ++i) {
+        int m = moves[i], k = keys[i], j = i - 1;
+        for (; j >= 0 && keys[j] < k; --j) {
+            moves[j + 1] = moves[j];
+            keys[j + 1] = keys[j];
+        }
+        moves[j + 1] = m;
+        keys[j + 1] = k;
+    }
+
+    int origAlpha = alpha;
+    int best = -WIN, bestMove = moves[0];
+
+    for (int i = 0; i < count; ++i) {
+        board->play(moves[i], side);
+        int val = -negamax(other, depth - 1, -beta, -alpha);
+        board->undo();
+        if (stopped) return 0;
+
+        if (val > best) {
+            best = val;
+            bestMove = moves[i];
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    slot.key = key;
+    slot.value = (int16_t)best;
+    slot.depth = (uint8_t)depth;
+    slot.move = (int8_t)bestMove;
+    slot.bound = best <= origAlpha ? UPPER : (best >= beta ? LOWER : EXACT);
+
+    return best;
+}
+
+int Ultimate_Engine::evaluate(char side) const
+{
+    // Centre sub-board and cell count most, corners next, edges least
+    static const int WEIGHT[9] = {3, 2, 3, 2, 4, 2, 3, 2, 3};
+
+    uint16_t wonX = board->get_won('X');
+    uint16_t wonO = board->get_won('O');
+    uint16_t decided = board->get_decided();
+    int score = 0;
+
+    for (uint16_t line : LINES) {
+        // Macro lines still open to one side, with two sub-boards already taken
+        if (!(line & (decided & ~wonX)) && __builtin_popcount(line & wonX) == 2) score += 40;
+        if (!(line & (decided & ~wonO)) && __builtin_popcount(line & wonO) == 2) score -= 40;
+    }
+
+    for (int sub = 0; sub < 9; ++sub) {
+        if (wonX >> sub & 1) { score += 10 * WEIGHT[sub]; continue; }
+        if (wonO >> sub & 1) { score -= 10 * WEIGHT[sub]; continue; }
+        if (decided >> sub & 1) continue;
+
+        uint16_t x = board->get_cells('X', sub);
+        uint16_t o = board->get_cells('O', sub);
+        for (uint16_t line : LINES) {
+            if (!(line & o) && __builtin_popcount(line & x) == 2) score += WEIGHT[sub];
+            if (!(line & x) && __builtin_popcount(line & o) == 2) score -= WEIGHT[sub];
+        }
+        score += (x >> 4 & 1) - (o >> 4 & 1);
+    }
+
+    return (side == 'X') ? score : -score;
+}
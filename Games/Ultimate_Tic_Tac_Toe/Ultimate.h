@@ -2,45 +2,171 @@
 #ifndef Ultimate_H
 #define Ultmate_H
 #include "../../header/BoardGame_Classes.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
 using namespace std;
 
 
+/**
+ * @brief Ultimate Tic-Tac-Toe board backed by nine 9-bit sub-boards per side.
+ *
+ * Cell c of sub-board s is bit c of cells[side][s] (both numbered row-major),
+ * and the engine addresses it as move 9 * s + c. A sub-board is won or full by
+ * a single lookup in a 512-entry table, and the macro board keeps a 9-bit mask
+ * of won and drawn sub-boards per side. The "send to board" rule is enforced:
+ * a move in cell c sends the opponent to sub-board c unless it is decided.
+ * The 9x9 character matrix and large_board are kept in sync for display only.
+ */
 class Ultimate_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
-    // char large_board[3][3];
-    int small_board=0;
-    bool full=true;
-    bool win=false;
+    uint16_t cells[2][9]{};  ///< Occupied cells of each sub-board, [0] = X, [1] = O.
+    uint16_t won[2]{};       ///< Sub-boards won by X ([0]) and O ([1]).
+    uint16_t drawn = 0;      ///< Sub-boards filled without a winner.
+    int next_board = -1;     ///< Sub-board the side to move must play in, -1 for any.
+    uint64_t hash = 0;       ///< Zobrist hash of the cells and next_board.
+    vector<pair<int, int>> history;   ///< Played moves with the next_board they replaced.
     vector<vector<char>> large_board = vector<vector<char>>(3, vector<char>(3, '.'));
- 
-  
+
+    /** @brief Recompute the won/drawn state of one sub-board after a change. */
+    void update_sub_board(int sub);
+
 public:
+    static const uint16_t FULL = 0x1FF;   ///< All nine cells of a sub-board.
+    static uint8_t line_table[512];       ///< 1 if the 9-bit mask holds three in a row.
+
     Ultimate_Board();
     bool update_board(Move<char>* move)override;
     bool is_win(Player<char>* player)override;
     bool is_draw(Player<char>* player) override;
     bool is_lose(Player<char>* player) { return false; }
     bool game_is_over(Player<char>* player) override;
-    void small_board_check(int x,int y, char sym);
     bool all_small_boards_done();
-   
 
-    
+    /**
+     * @brief Write every legal move (9 * sub + cell) for the side to move.
+     * @param moves Output array with room for 81 moves.
+     * @return The number of moves written.
+     */
+    int legal_moves(int* moves) const;
+
+    /** @brief True if move 9 * sub + cell is legal for the side to move. */
+    bool can_play(int move) const;
+
+    /** @brief Play move 9 * sub + cell (must be legal) without any output. */
+    void play(int move, char mark);
+
+    /** @brief Take back the last move played. */
+    void undo();
+
+    /** @brief Sub-board the side to move is sent to, -1 for any open sub-board. */
+    int get_next_board() const { return next_board; }
+
+    /** @brief Occupied cells of one sub-board for a symbol. */
+    uint16_t get_cells(char mark, int sub) const { return cells[mark == 'X' ? 0 : 1][sub]; }
+
+    /** @brief Sub-boards won by a symbol. */
+    uint16_t get_won(char mark) const { return won[mark == 'X' ? 0 : 1]; }
+
+    /** @brief Sub-boards that are won by either side or drawn. */
+    uint16_t get_decided() const { return won[0] | won[1] | drawn; }
+
+    /** @brief Zobrist hash of the position, including the forced sub-board. */
+    uint64_t get_hash() const { return hash; }
+
+    /** @brief Number of moves played. */
+    int get_moves() const { return n_moves; }
+
+    /** @brief Convert board coordinates to a move index (9 * sub + cell). */
+    static int to_move(int x, int y) { return 9 * (3 * (x / 3) + y / 3) + 3 * (x % 3) + y % 3; }
+
+    /** @brief Row of a move index on the 9x9 board. */
+    static int move_x(int move) { return 3 * (move / 9 / 3) + move % 9 / 3; }
+
+    /** @brief Column of a move index on the 9x9 board. */
+    static int move_y(int move) { return 3 * (move / 9 % 3) + move % 9 % 3; }
+};
+
+
+/**
+ * @brief Alpha-beta search engine for Ultimate Tic-Tac-Toe.
+ *
+ * Negamax with a transposition table keyed by the board's Zobrist hash,
+ * iterative deepening under a time budget, and moves generated straight from
+ * the sub-board masks so only legal moves are ever considered.
+ */
+class Ultimate_Engine {
+public:
+    /**
+     * @brief Construct the engine and allocate its transposition table.
+     * @param tableBits log2 of the number of transposition table entries.
+     */
+    explicit Ultimate_Engine(int tableBits = 20);
+
+    /**
+     * @brief Search the board until the time budget runs out (the board is restored).
+     * @param board The live game board.
+     * @param toMove The symbol of the side to move.
+     * @param timeLimitMs Time budget in milliseconds.
+     * @param maxDepth Upper bound on the iterative deepening depth.
+     * @return The best move as 9 * sub + cell.
+     */
+    int best_move(Ultimate_Board* board, char toMove, int timeLimitMs, int maxDepth = 30);
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = 0;       ///< Zobrist hash, 0 when empty.
+        int16_t value = 0;      ///< Stored score.
+        uint8_t depth = 0;      ///< Depth the score was searched to.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+        int8_t move = -1;       ///< Best move found in this position.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @brief Negamax alpha-beta search.
+     * @return Score for the side to move; WIN - moves for a won game.
+     */
+    int negamax(char side, int depth, int alpha, int beta);
+
+    /**
+     * @brief Static evaluation: won sub-boards and macro lines, plus open twos inside open sub-boards.
+     * @return Score for the side to move.
+     */
+    int evaluate(char side) const;
+
+    static const int WIN = 10000;               ///< Base score of a win (minus the moves played).
+
+    Ultimate_Board* board = nullptr;            ///< Board being searched.
+    vector<Entry> table;                        ///< Transposition table (power of two size).
+    uint64_t tableMask;                         ///< Index mask for the table.
+    std::chrono::steady_clock::time_point deadline;   ///< Time at which the search stops.
+    long long nodes = 0;                        ///< Nodes visited in the current search.
+    bool stopped = false;                       ///< True once the time budget ran out.
 };
 
 
 class Ultimate_UI : public UI<char> {
+private:
+    Ultimate_Engine engine;     ///< Search engine used by the computer player.
+    int timeLimitMs = 1000;     ///< Thinking time per computer move.
+    char large_board[3][3] = {{'.', '.', '.'}, {'.', '.', '.'}, {'.', '.', '.'}};   ///< Sub-board results, kept from board events.
 public:
 
     Ultimate_UI();
 
-   
+
     ~Ultimate_UI() {};
     Player<char>* create_player(string& name, char symbol, PlayerType type) override;
     Move<char>* get_move(Player<char>* player) override;
     void display_board_matrix(const vector<vector<char>>& matrix) const override;
-    
+    void on_sub_board_won(int sub_row, int sub_col, char winner) override;
+
 };
 
 #endif  //Ultimate_Tic_Tac_Toe
@@ -1,15 +1,30 @@
 #include "Word_Tic_Tac_Toe.h"
+#include "Word_XO_Dictionary.h"
+#include "../../header/Random.h"
+#include "../../header/Symmetry.h"
+#include <cctype>
+#include <cstdlib>
 #include <iostream>
-#include <random>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // ============================================================================
 // Static Member Initialization
 // ============================================================================
 
-// Initialize the static dictionary sets outside the class definition.
-// These sets hold all valid words and their reverses for the game.
-std::set<std::string> Word_XO_Board::dict;
-std::set<std::string> Word_XO_Board::revDict;
+// Initialize the static dictionary tables outside the class definition.
+// They hold all valid words, the words readable in either direction, and
+// the letters completing each (position, letter, letter) pattern.
+std::bitset<Word_XO_Board::WORDS> Word_XO_Board::dict;
+std::bitset<Word_XO_Board::WORDS> Word_XO_Board::lineWords;
+uint32_t Word_XO_Board::completionMask[3][26 * 26];
+bool Word_XO_Board::dictionaryReady = false;
+bool Word_XO_Board::customDictionary = false;
 
 std::vector<std::pair<int, char>> Word_XO_UI::score[3][3];
 
@@ -23,23 +38,8 @@ std::vector<std::pair<int, char>> Word_XO_UI::score[3][3];
 
 Word_XO_Board::Word_XO_Board() : Board(3, 3), emptyCell('.')
 { 
-    // Check if the static dictionary has already been loaded.
-    // This ensures the dictionary is only loaded once, even if multiple boards are created.
-    if(dict.empty()) {
-        // Attempt to open the dictionary file.
-        std::ifstream in("dic.txt");
-        
-        // If the file fails to open, throw a runtime exception.
-        if (in.fail()) throw std::runtime_error("Can't Find \"dic.txt\"");
-        
-        // Extract words from the file and insert them into the static set.
-        std::string word;
-        while(in >> word) {
-            dict.insert(word);
-            std::reverse(word.begin(), word.end());
-            revDict.insert(word);
-        }
-    }
+    // Set up the dictionary tables; only the first board (or UI) does any work.
+    initDictionary();
 
     // Initialize all board cells to the empty cell marker.
     for (auto &row : board)
@@ -63,49 +63,144 @@ int Word_XO_Board::getMoveCount()
 
 bool Word_XO_Board::wordExist()
 {
-    std::string word;
-    bool isFound = false;
-    
-    // Check Horizontal Lines
-    for(int r = 0; r < 3; ++r) {
-        word.clear();
-        word.push_back(board[r][0]);
-        word.push_back(board[r][1]);
-        word.push_back(board[r][2]);
-        
-        isFound |= (dict.find(word) != dict.end());
-        isFound |= (revDict.find(word) != revDict.end());
+    // Check Horizontal and Vertical Lines
+    for(int i = 0; i < 3; ++i) {
+        if (isLineWord(board[i][0], board[i][1], board[i][2])) return true;
+        if (isLineWord(board[0][i], board[1][i], board[2][i])) return true;
     }
-    
-    // Check Vertical Lines
-    for(int c = 0; c < 3; ++c) {
-        word.clear();
-        word.push_back(board[0][c]);
-        word.push_back(board[1][c]);
-        word.push_back(board[2][c]);
-        
-        isFound |= (dict.find(word) != dict.end());
-        isFound |= (revDict.find(word) != revDict.end());
+
+    // Check Main Diagonal and Anti-Diagonal
+    return isLineWord(board[0][0], board[1][1], board[2][2]) ||
+           isLineWord(board[0][2], board[1][1], board[2][0]);
+}
+
+// ----------------------------------------------------------------------------
+// Dictionary Queries
+// ----------------------------------------------------------------------------
+
+int Word_XO_Board::wordIndex(char a, char b, char c)
+{
+    // Unsigned wrap-around sends anything below 'A' past 25 as well.
+    unsigned x = a - 'A', y = b - 'A', z = c - 'A';
+    if (x > 25 || y > 25 || z > 25) return -1;
+    return int(x * 676 + y * 26 + z);
+}
+
+bool Word_XO_Board::isLineWord(char a, char b, char c)
+{
+    int w = wordIndex(a, b, c);
+    return w >= 0 && lineWords[w];
+}
+
+uint32_t Word_XO_Board::completions(int pos, char a, char b)
+{
+    unsigned x = a - 'A', y = b - 'A';
+    if (pos < 0 || pos > 2 || x > 25 || y > 25) return 0;
+    return completionMask[pos][x * 26 + y];
+}
+
+// ----------------------------------------------------------------------------
+// Dictionary Setup
+// ----------------------------------------------------------------------------
+
+void Word_XO_Board::initDictionary()
+{
+    if (dictionaryReady) return;
+    dictionaryReady = true;
+
+    // An override file, if one is named and readable
+    const char* path = std::getenv("WORD_XO_DICTIONARY");
+    if (path && *path) {
+        if (loadDictionary(path)) return;
+        std::cerr << "Can't load \"" << path << "\", using the built-in dictionary\n";
+    }
+
+    // The embedded dictionary: its bitset was built by the compiler
+    std::bitset<WORDS> words;
+    for (int w = 0; w < WORDS; ++w)
+        if (Word_XO_Dictionary::BITS.word[w / 64] >> (w % 64) & 1) words.set(w);
+    setDictionary(words);
+}
+
+bool Word_XO_Board::loadDictionary(const std::string& path)
+{
+    std::bitset<WORDS> words;
+
+    // Collect whitespace-separated tokens of exactly 3 letters
+    auto scan = [&words](const char* text, size_t size) {
+        size_t i = 0;
+        while (i < size) {
+            while (i < size && std::isspace((unsigned char)text[i])) ++i;
+            size_t start = i;
+            while (i < size && !std::isspace((unsigned char)text[i])) ++i;
+            if (i - start != 3) continue;
+
+            int w = wordIndex(std::toupper((unsigned char)text[start]),
+                              std::toupper((unsigned char)text[start + 1]),
+                              std::toupper((unsigned char)text[start + 2]));
+            if (w >= 0) words.set(w);
+        }
+    };
+
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
     }
 
-    // Check Main Diagonal
-    word.clear();
-    for(int rc = 0; rc < 3; ++rc) {
-        word.push_back(board[rc][rc]); 
+    void* data = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    scan(static_cast<const char*>(data), size_t(info.st_size));
+    munmap(data, size_t(info.st_size));
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (in.fail()) return false;
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    scan(text.data(), text.size());
+#endif
+
+    if (words.none()) return false;
+
+    dictionaryReady = true;
+    customDictionary = true;
+    setDictionary(words);
+    return true;
+}
+
+bool Word_XO_Board::hasCustomDictionary()
+{
+    return customDictionary;
+}
+
+void Word_XO_Board::setDictionary(const std::bitset<WORDS>& words)
+{
+    dict = words;
+    lineWords.reset();
+    for (auto& row : completionMask)
+        for (auto& mask : row) mask = 0;
+
+    // A line may read either way, so every word also counts reversed
+    for (int w = 0; w < WORDS; ++w) {
+        if (!dict[w]) continue;
+        lineWords.set(w);
+        lineWords.set((w % 26) * 676 + (w / 26 % 26) * 26 + w / 676);
     }
-    isFound |= (dict.find(word) != dict.end());
-    isFound |= (revDict.find(word) != revDict.end());
 
-    // Check Anti-Diagonal
-    word.clear();
-    for(int rc = 0; rc < 3; ++rc) {
-        word.push_back(board[rc][2 - rc]); 
+    // For every line word, record its letter at each position as a completion
+    // of the other two: completionMask[pos][26 * first + second].
+    for (int w = 0; w < WORDS; ++w) {
+        if (!lineWords[w]) continue;
+        int l[3] = {w / 676, w / 26 % 26, w % 26};
+        completionMask[0][l[1] * 26 + l[2]] |= 1u << l[0];
+        completionMask[1][l[0] * 26 + l[2]] |= 1u << l[1];
+        completionMask[2][l[0] * 26 + l[1]] |= 1u << l[2];
     }
-    isFound |= (dict.find(word) != dict.end());
-    isFound |= (revDict.find(word) != revDict.end());
-    
-    // Return true if any word is found on the board.
-    return isFound;
 }
 
 // ----------------------------------------------------------------------------
@@ -122,7 +217,9 @@ bool Word_XO_Board::update_board(Move<char> *move)
     // Check for invalid input conditions:
     // 1. Coordinates out of 3x3 bounds (0-2).
     // 2. Attempting to place a symbol (sym != 0) on an already occupied cell.
+    // 3. Placing anything but a letter 'A'-'Z'.
     if (r > 2 || c > 2 || (board[r][c] != emptyCell && sym != 0)) return false;
+    if (sym != 0 && (sym < 'A' || sym > 'Z')) return false;
 
     // --- Undo Logic (sym == 0) ---
     if (sym == 0) {
@@ -171,6 +268,327 @@ bool Word_XO_Board::is_draw(Player<char> *player)
     return !is_win(player) && !is_lose(player) && nMoves == 9;
 }
 
+// ============================================================================
+// Word_XO_Solver Implementation
+// ============================================================================
+
+// Cells of the 8 lines in reading order: rows, columns, then both diagonals.
+static const int LINES[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+    {0, 4, 8}, {2, 4, 6}
+};
+
+// For each cell, the lines through it and the cell's position in each.
+static int cellLineCount[9];
+static int cellLines[9][4][2];
+
+uint8_t Word_XO_Solver::letterClass[26];
+uint8_t Word_XO_Solver::profileId[3][26];
+uint32_t Word_XO_Solver::dangerMask[3][3][26];
+bool Word_XO_Solver::tablesReady = false;
+
+// ----------------------------------------------------------------------------
+// Constructors
+// ----------------------------------------------------------------------------
+
+Word_XO_Solver::Word_XO_Solver(int tableBits, long long nodeBudget)
+    : tableMask((uint64_t(1) << tableBits) - 1), nodeBudget(nodeBudget)
+{
+}
+
+void Word_XO_Solver::initTables()
+{
+    // Lines through every cell
+    for (int l = 0; l < 8; ++l)
+        for (int p = 0; p < 3; ++p) {
+            int c = LINES[l][p];
+            cellLines[c][cellLineCount[c]][0] = l;
+            cellLines[c][cellLineCount[c]][1] = p;
+            ++cellLineCount[c];
+        }
+
+    // Word profile of a letter at each line position: which pairs of other letters
+    // (in line order) make a word with it. Equal profiles get the same id.
+    std::bitset<26 * 26> profile[3][26];
+    for (int p = 0; p < 3; ++p)
+        for (int l = 0; l < 26; ++l)
+            for (int x = 0; x < 26; ++x)
+                for (int y = 0; y < 26; ++y)
+                    if (Word_XO_Board::completions(p, 'A' + x, 'A' + y) >> l & 1)
+                        profile[p][l].set(x * 26 + y);
+
+    for (int p = 0; p < 3; ++p)
+        for (int l = 0; l < 26; ++l) {
+            profileId[p][l] = l;
+            for (int k = 0; k < l; ++k)
+                if (profile[p][k] == profile[p][l]) { profileId[p][l] = profileId[p][k]; break; }
+        }
+
+    // Reversed lines read the same, so the end profile follows from the start profile
+    // and a letter's class only needs its start and middle profiles
+    for (int l = 0; l < 26; ++l) {
+        letterClass[l] = l;
+        for (int k = 0; k < l; ++k)
+            if (profileId[0][k] == profileId[0][l] && profileId[1][k] == profileId[1][l]) {
+                letterClass[l] = letterClass[k];
+                break;
+            }
+    }
+
+    // A letter at newPos next to otherLetter at otherPos is dangerous if some
+    // letter at the remaining position would then complete a word
+    for (int np = 0; np < 3; ++np)
+        for (int op = 0; op < 3; ++op) {
+            if (op == np) continue;
+            int ep = 3 - np - op;
+            for (int ol = 0; ol < 26; ++ol)
+                for (int l = 0; l < 26; ++l) {
+                    char first = 'A' + (np < op ? l : ol);
+                    char second = 'A' + (np < op ? ol : l);
+                    if (Word_XO_Board::completions(ep, first, second))
+                        dangerMask[np][op][ol] |= 1u << l;
+                }
+        }
+
+    tablesReady = true;
+}
+
+// ----------------------------------------------------------------------------
+// Search
+// ----------------------------------------------------------------------------
+
+bool Word_XO_Solver::solve(Word_XO_Board* board, int& row, int& col, char& letter)
+{
+    if (!tablesReady) initTables();
+
+    // The table is allocated on the first solve, so creating the UI stays instant
+    if (table.empty()) table.resize(tableMask + 1);
+
+    filled = 0;
+    for (int c = 0; c < 9; ++c) {
+        char ch = board->get_cell(c / 3, c % 3);
+        cells[c] = (ch >= 'A' && ch <= 'Z') ? ch - 'A' : -1;
+        filled += cells[c] >= 0;
+    }
+    if (filled == 9) return false;
+
+    nodes = 0;
+    stopped = false;
+
+    int best = -1;
+    int win = winningMove();
+    if (win >= 0) {
+        best = win;
+        score = WIN - (filled + 1);
+    }
+    else {
+        uint8_t moves[9 * 26];
+        int count = safeMoves(moves);
+
+        // Every move hands the opponent a word, or only the last cell is left:
+        // the result is fixed, so any letter in any empty cell will do
+        if (count == 0) {
+            for (int c = 0; c < 9 && best < 0; ++c)
+                if (cells[c] < 0) best = c * 26;
+            score = (filled == 8) ? 0 : -(WIN - (filled + 2));
+        }
+        else {
+            // Search every root move with a window that still detects ties,
+            // then pick one of the equally good moves at random. Moves leading
+            // to symmetric positions are searched once.
+            Random& gen = Random::local();
+            vector<int> bestMoves;
+            vector<uint64_t> searched;
+            score = -WIN;
+
+            for (int i = 0; i < count; ++i) {
+                int c = moves[i] / 26;
+                cells[c] = moves[i] % 26;
+                ++filled;
+                uint64_t key = canonicalKey();
+                if (std::find(searched.begin(), searched.end(), key) != searched.end()) {
+                    cells[c] = -1;
+                    --filled;
+                    continue;
+                }
+                searched.push_back(key);
+                int value = -negamax(-WIN, -(score - 1));
+                cells[c] = -1;
+                --filled;
+                if (stopped) return false;
+
+                if (value > score) {
+                    score = value;
+                    bestMoves.assign(1, moves[i]);
+                }
+                else if (value == score) {
+                    bestMoves.push_back(moves[i]);
+                }
+            }
+            best = bestMoves[gen.below(uint32_t(bestMoves.size()))];
+        }
+    }
+
+    row = best / 26 / 3;
+    col = best / 26 % 3;
+    letter = 'A' + best % 26;
+    return true;
+}
+
+int Word_XO_Solver::negamax(int alpha, int beta)
+{
+    if (++nodes > nodeBudget) stopped = true;
+    if (stopped) return 0;
+
+    // The side to move completes a word if it can
+    if (winningMove() >= 0) return WIN - (filled + 1);
+
+    // With one cell left and nothing completable, the last letter makes no word
+    if (filled >= 8) return 0;
+
+    uint64_t key = canonicalKey() + 1;
+    Entry& entry = table[(key * 0x9E3779B97F4A7C15ULL >> 20) & tableMask];
+    int hint = 255;
+    if (entry.key == key) {
+        if (entry.bound == EXACT) return entry.value;
+        if (entry.bound == LOWER && entry.value >= beta) return entry.value;
+        if (entry.bound == UPPER && entry.value <= alpha) return entry.value;
+        hint = entry.move;
+    }
+
+    uint8_t moves[9 * 26];
+    int count = safeMoves(moves);
+
+    // Every move leaves a word for the opponent
+    if (count == 0) return -(WIN - (filled + 2));
+
+    // Try the stored best move first; it may come from a symmetric position,
+    // in which case it is simply not found here
+    for (int i = 1; i < count && hint != 255; ++i)
+        if (moves[i] == hint) {
+            std::swap(moves[0], moves[i]);
+            break;
+        }
+
+    int alphaOrig = alpha;
+    int bestValue = -WIN;
+    int bestMove = moves[0];
+
+    for (int i = 0; i < count; ++i) {
+        int c = moves[i] / 26;
+        cells[c] = moves[i] % 26;
+        ++filled;
+        int value = -negamax(-beta, -alpha);
+        cells[c] = -1;
+        --filled;
+        if (stopped) return 0;
+
+        if (value > bestValue) {
+            bestValue = value;
+            bestMove = moves[i];
+        }
+        if (value > alpha) alpha = value;
+        if (alpha >= beta) break;
+    }
+
+    entry.key = key;
+    entry.value = bestValue;
+    entry.move = bestMove;
+    entry.bound = bestValue <= alphaOrig ? UPPER : bestValue >= beta ? LOWER : EXACT;
+    return bestValue;
+}
+
+int Word_XO_Solver::winningMove() const
+{
+    for (const auto& line : LINES) {
+        int empty = -1, present[2], n = 0;
+        for (int p = 0; p < 3; ++p) {
+            if (cells[line[p]] < 0) {
+                if (empty >= 0) { n = -1; break; }
+                empty = p;
+            }
+            else if (n < 2) {
+                present[n++] = cells[line[p]];
+            }
+        }
+        if (empty < 0 || n != 2) continue;
+
+        uint32_t mask = Word_XO_Board::completions(empty, 'A' + present[0], 'A' + present[1]);
+        if (mask) return line[empty] * 26 + __builtin_ctz(mask);
+    }
+    return -1;
+}
+
+int Word_XO_Solver::safeMoves(uint8_t* moves) const
+{
+    int count = 0;
+
+    for (int c = 0; c < 9; ++c) {
+        if (cells[c] >= 0) continue;
+
+        // Lines through c that would be left with two letters constrain the
+        // letter; lines with no other letter stay open and decide its class
+        uint32_t unsafe = 0;
+        int openPositions = 0;
+
+        for (int k = 0; k < cellLineCount[c]; ++k) {
+            const int* line = LINES[cellLines[c][k][0]];
+            int pos = cellLines[c][k][1];
+            int others = 0, otherPos = -1;
+
+            for (int p = 0; p < 3; ++p)
+                if (p != pos && cells[line[p]] >= 0) { ++others; otherPos = p; }
+
+            if (others == 0) openPositions |= 1 << pos;
+            else if (others == 1) unsafe |= dangerMask[pos][otherPos][cells[line[otherPos]]];
+        }
+
+        // One letter per distinct profile over the open positions
+        uint32_t seen[26];
+        int classes = 0;
+
+        for (int l = 0; l < 26; ++l) {
+            if (unsafe >> l & 1) continue;
+
+            uint32_t signature = 0;
+            for (int p = 0; p < 3; ++p)
+                signature = signature * 32 + ((openPositions >> p & 1) ? profileId[p][l] + 1 : 0);
+
+            bool duplicate = false;
+            for (int k = 0; k < classes && !duplicate; ++k)
+                duplicate = seen[k] == signature;
+            if (duplicate) continue;
+
+            seen[classes++] = signature;
+            moves[count++] = c * 26 + l;
+        }
+    }
+    return count;
+}
+
+uint64_t Word_XO_Solver::canonicalKey() const
+{
+    // Cell codes: 0 empty, 1 a letter whose lines are all settled, 2 + class
+    // for a letter that is still alone on some line, packed 5 bits per cell
+    uint64_t packed = 0;
+    for (int c = 0; c < 9; ++c) {
+        if (cells[c] < 0) continue;
+
+        bool open = false;
+        for (int k = 0; k < cellLineCount[c] && !open; ++k) {
+            const int* line = LINES[cellLines[c][k][0]];
+            open = true;
+            for (int p = 0; p < 3; ++p)
+                if (line[p] != c && cells[line[p]] >= 0) open = false;
+        }
+        packed |= uint64_t(open ? 2 + letterClass[cells[c]] : 1) << (5 * c);
+    }
+
+    int transform;
+    return Symmetry<3, 5>::canonical(packed, transform);
+}
+
 // ============================================================================
 // Word_XO_UI Implementation
 // ============================================================================
@@ -181,11 +599,21 @@ bool Word_XO_Board::is_draw(Player<char> *player)
 
 Word_XO_UI::Word_XO_UI() : Custom_UI<char>("Word Tic Tac Toe"s, 5)
 {
-    // Pre-compute scores for all board positions on first instantiation.
+    Word_XO_Board::initDictionary();
+
+    // Fill the scores of all board positions on first instantiation: copied from
+    // the compile-time tables, or computed if a custom dictionary is in use.
     if (score[0][0].empty()) {
         for(int r = 0; r < 3; ++r) {
             for(int c = 0; c < 3; ++c) {
-                score[r][c] = evaluate(r, c);
+                if (Word_XO_Board::hasCustomDictionary()) {
+                    score[r][c] = evaluate(r, c);
+                    continue;
+                }
+                int posType = ((r == 1 && c == 1) ? 1 : ((r == 0 || r == 2) && (c == 0 || c == 2)) ? 0 : 2);
+                for (int k = 0; k < 26; ++k)
+                    score[r][c].push_back({Word_XO_Dictionary::SCORES.score[posType][k],
+                                           Word_XO_Dictionary::SCORES.letter[posType][k]});
             }
         }
     }
@@ -211,15 +639,20 @@ Move<char> *Word_XO_UI::get_move(Player<char> *player)
     }
     // Handle Computer (random) player
     else if (player->get_type() == PlayerType::COMPUTER) {
-        r = std::rand() % 5;
-        c = std::rand() % 5;
-        sym = std::rand() % 26 + 'A';
+        Random& gen = Random::local();
+        r = gen.below(3);
+        c = gen.below(3);
+        sym = 'A' + gen.below(26);
     }
     // Handle AI player
     else if (player->get_type() == PlayerType::AI) {
-        auto move = bestMove(player);
-        r = std::get<0>(move), c = std::get<1>(move), sym = std::get<2>(move);
-        cout << "\n\n R: " << r << ", C: " << c << ", Sym: " << c << "\n\n";
+        // Play the solver's move; fall back to the heuristic if it runs out of budget
+        auto* board = dynamic_cast<Word_XO_Board*>(player->get_board_ptr());
+        if (!solver.solve(board, r, c, sym)) {
+            auto move = bestMove(player);
+            r = std::get<0>(move), c = std::get<1>(move), sym = std::get<2>(move);
+        }
+        cout << "\n\n R: " << r << ", C: " << c << ", Sym: " << sym << "\n\n";
     }
 
     // Set the current player as the last player to make a move.
@@ -234,14 +667,12 @@ Move<char> *Word_XO_UI::get_move(Player<char> *player)
 std::tuple<int, int, char> Word_XO_UI::bestMove(Player<char> *player)
 {
     Word_XO_Board* board = dynamic_cast<Word_XO_Board*>(player->get_board_ptr());
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    Random& gen = Random::local();
 
     // First move: prioritize center with high-scoring character
     if(board->getMoveCount() == 0) {
         int topCount = std::max(1, (int)(score[1][1].size() * 0.3));
-        std::uniform_int_distribution<int> dis(0, topCount - 1);
-        return {1, 1, score[1][1][dis(gen)].second};
+        return {1, 1, score[1][1][gen.below(topCount)].second};
     }
     
     // Define all possible lines (rows, columns, diagonals)
@@ -255,44 +686,25 @@ std::tuple<int, int, char> Word_XO_UI::bestMove(Player<char> *player)
     };
 
     // Lambda function to check if a line can form a word with one more character
-    auto check_line_for_word = [&](std::vector<std::pair<int, int>> line) -> tuple<int,int,char> {
-        int emptyR = -1;
-        int emptyC = -1;
+    auto check_line_for_word = [&](const std::vector<std::pair<int, int>>& line) -> tuple<int,int,char> {
+        int emptyPos = -1;
+        char present[2];
         int filledCount = 0;
 
-        // Count filled cells and locate the empty one
-        for (const auto& coord : line) {
-            if (board->get_cell(coord.first, coord.second) == board->getEmptyCell()) {
-                emptyR = coord.first;
-                emptyC = coord.second;
-            } else {
-                ++filledCount;
-            }
+        // Count filled cells, keep their letters in line order and locate the empty one
+        for (int k = 0; k < 3; ++k) {
+            char cell = board->get_cell(line[k].first, line[k].second);
+            if (cell == board->getEmptyCell()) emptyPos = k;
+            else if (filledCount < 2) present[filledCount++] = cell;
+            else ++filledCount;
         }
 
-        // If exactly 2 cells are filled, check if any character completes a word
+        // If exactly 2 cells are filled, one mask lookup gives every completing letter;
+        // the lowest one is the first in alphabetical order
         if (filledCount == 2) {
-            for (char sym = 'A'; sym <= 'Z'; ++sym) {
-                std::string temp_word = "";
-                
-                // Build the potential word
-                for (const auto& coord : line) {
-                    if (coord.first == emptyR && coord.second == emptyC) {
-                        temp_word.push_back(sym);
-                    } else {
-                        temp_word.push_back(board->get_cell(coord.first, coord.second));
-                    }
-                }
-                
-                // Check if the word exists in dictionary or reverse dictionary
-                if (Word_XO_Board::dict.find(temp_word) != Word_XO_Board::dict.end()) {
-                    return {emptyR, emptyC, sym};
-                }
-
-                if (Word_XO_Board::revDict.find(temp_word) != Word_XO_Board::revDict.end()) {
-                    return {emptyR, emptyC, sym};
-                }
-            }
+            uint32_t mask = Word_XO_Board::completions(emptyPos, present[0], present[1]);
+            if (mask)
+                return {line[emptyPos].first, line[emptyPos].second, char('A' + __builtin_ctz(mask))};
         }
 
         return {-1, -1, 0};
@@ -309,8 +721,7 @@ std::tuple<int, int, char> Word_XO_UI::bestMove(Player<char> *player)
     }
 
     if (!winningMoves.empty()) {
-        std::uniform_int_distribution<int> dis(0, winningMoves.size() - 1);
-        auto [r, c, ch] = winningMoves[dis(gen)];
+        auto [r, c, ch] = winningMoves[gen.below(winningMoves.size())];
         return {r, c, ch};
     }
 
@@ -358,11 +769,10 @@ std::tuple<int, int, char> Word_XO_UI::bestMove(Player<char> *player)
     
     // 4. Select the best safe move based on pre-computed scores
     if(!safeMoves.empty()) {
-        int i = std::rand() % safeMoves.size();
+        int i = gen.below(safeMoves.size());
         int r = safeMoves[i].first, c = safeMoves[i].second;
         int topCount = std::max(1, (int)(score[r][c].size() * 0.3));
-        std::uniform_int_distribution<int> dis(0, topCount - 1);
-        return {r, c, score[r][c][dis(gen)].second}; 
+        return {r, c, score[r][c][gen.below(topCount)].second}; 
     }
 
     // 5. Block opponent - find characters that make lines invalid
@@ -393,13 +803,11 @@ std::tuple<int, int, char> Word_XO_UI::bestMove(Player<char> *player)
     }
 
     if(!blockMoves.empty()) {
-        std::uniform_int_distribution<int> dis(0, blockMoves.size() - 1);
-        return blockMoves[dis(gen)];
+        return blockMoves[gen.below(blockMoves.size())];
     }
     
     // 6. Fallback - random move if no strategic move is found
-    std::uniform_int_distribution<int> dis('A', 'Z');
-    return {emptyCells[0].first, emptyCells[0].second, (char)dis(gen)};
+    return {emptyCells[0].first, emptyCells[0].second, char('A' + gen.below(26))};
 }
 
 std::vector<std::pair<int, char>> Word_XO_UI::evaluate(size_t r, size_t c)
@@ -415,7 +823,9 @@ std::vector<std::pair<int, char>> Word_XO_UI::evaluate(size_t r, size_t c)
         std::set<char> s2;
 
         // Check all words in dictionary
-        for(auto& word : Word_XO_Board::dict) {
+        for(int w = 0; w < Word_XO_Board::WORDS; ++w) {
+            if(!Word_XO_Board::dict[w]) continue;
+            char word[3] = {char('A' + w / 676), char('A' + w / 26 % 26), char('A' + w % 26)};
             if(word[posType] != ch) continue;
             
             int temp = 0;
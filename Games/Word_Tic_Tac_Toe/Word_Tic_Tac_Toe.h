@@ -4,6 +4,7 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/Custom_UI.h"
 #include "../../header/AI.h"
+#include <bitset>
 #include <cstdint>
 #include <set>
 #include <fstream>
@@ -31,8 +32,8 @@ public:
     /**
      * @brief Constructor for the Word_XO_Board.
      * 
-     * Initializes the board dimensions and internal state. It is typically 
-     * responsible for loading the dictionary for move.
+     * Initializes the board dimensions and internal state, and sets up the
+     * dictionary on first use (see initDictionary()).
      */
     Word_XO_Board();
 
@@ -58,6 +59,58 @@ public:
      */
     bool wordExist();
 
+    // ------------------------------------------------------------------------
+    // Dictionary Queries
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Index of a letter triple in the dictionary bitsets.
+     * @return 676 * a + 26 * b + c for letters 'A'-'Z', or -1 if any character is not a letter.
+     */
+    static int wordIndex(char a, char b, char c);
+
+    /**
+     * @brief Checks if three letters read as a word in either direction.
+     * @return `true` if the triple or its reverse is in the dictionary.
+     */
+    static bool isLineWord(char a, char b, char c);
+
+    /**
+     * @brief Letters that complete a line into a word (in either direction).
+     * @param pos Position of the missing letter in the line (0-2).
+     * @param a First of the two present letters, in line order.
+     * @param b Second of the two present letters, in line order.
+     * @return Bit i is set if letter 'A' + i completes the line; 0 for non-letters.
+     */
+    static uint32_t completions(int pos, char a, char b);
+
+    /**
+     * @brief Set up the dictionary tables once; later calls do nothing.
+     *
+     * Uses the dictionary embedded at compile time (Word_XO_Dictionary.h), so no
+     * file is needed. If the WORD_XO_DICTIONARY environment variable names a
+     * readable word list, that file replaces it.
+     */
+    static void initDictionary();
+
+    /**
+     * @brief Replace the dictionary with a word list file.
+     *
+     * The file is memory-mapped where the platform allows it and scanned for
+     * whitespace-separated 3-letter words (any case); other tokens are skipped.
+     * Call it before the first game, since the AI caches tables derived from it.
+     *
+     * @param path Path of the word list.
+     * @return `true` if the file held at least one word; `false` leaves the dictionary unchanged.
+     */
+    static bool loadDictionary(const std::string& path);
+
+    /**
+     * @brief Checks if a word list file replaced the embedded dictionary.
+     * @return `true` after a successful loadDictionary().
+     */
+    static bool hasCustomDictionary();
+
     // ------------------------------------------------------------------------
     // Board Updates
     // ------------------------------------------------------------------------
@@ -131,8 +184,11 @@ public:
     // Static Members
     // ------------------------------------------------------------------------
     
-    static std::set<std::string> dict;      ///< Static set of valid words used for scoring and move validation (if applicable).
-    static std::set<std::string> revDict;   ///< Static set of valid reverse words used for scoring and move validation (if applicable).
+    static const int WORDS = 26 * 26 * 26;           ///< Number of letter triples.
+
+    static std::bitset<WORDS> dict;                  ///< Valid words, indexed by wordIndex().
+    static std::bitset<WORDS> lineWords;             ///< Valid words and their reverses, so a line may read either way.
+    static uint32_t completionMask[3][26 * 26];      ///< [missing position][two present letters] -> completing letters.
 
 private:
     // ------------------------------------------------------------------------
@@ -142,6 +198,122 @@ private:
     int nMoves = 0;                         ///< Counter for the number of moves played so far.
     char emptyCell;                         ///< The character representing an empty, available cell.
     Player<char>* lastPlayer;               ///< Pointer to the player who executed the last move.
+
+    /**
+     * @brief Install a dictionary and derive the line word and completion tables from it.
+     * @param words The dictionary words, indexed by wordIndex().
+     */
+    static void setDictionary(const std::bitset<WORDS>& words);
+
+    static bool dictionaryReady;            ///< initDictionary() has run.
+    static bool customDictionary;           ///< The dictionary came from a file.
+};
+
+// ============================================================================
+// Word_XO_Solver Class
+// ============================================================================
+
+/**
+ * @class Word_XO_Solver
+ * @brief Exact negamax search for Word Tic-Tac-Toe.
+ *
+ * The search works on abstract line states rather than raw letters:
+ *  - A move that completes a word wins at once, so a position with a
+ *    completable line (two letters and a nonzero completion mask) is scored
+ *    without generating moves.
+ *  - Any other move that leaves a completable line loses at once, so only
+ *    "safe" letters are searched.
+ *  - A line holding two letters in a safe position can never become a word,
+ *    so it is dead; only the letter of a line whose other cells are empty
+ *    still matters, and only through the words it can start, end or center.
+ *    Letters with the same word profile at those positions are equivalent
+ *    and one of them is searched.
+ *
+ * Positions are stored in a transposition table under a key of per-cell
+ * codes (empty, dead letter or letter class), minimised over the 8 board
+ * symmetries. A node budget bounds the search; if it runs out the caller
+ * falls back to the heuristic.
+ */
+class Word_XO_Solver {
+public:
+    /**
+     * @brief Construct the solver; its transposition table is allocated on the first solve.
+     * @param tableBits log2 of the number of transposition table entries.
+     * @param nodeBudget Nodes a single solve may visit before giving up.
+     */
+    explicit Word_XO_Solver(int tableBits = 20, long long nodeBudget = 20000000);
+
+    /**
+     * @brief Find an optimal move for the side to move (the board is not changed).
+     * @param board The live game board.
+     * @param row Output row of the move.
+     * @param col Output column of the move.
+     * @param letter Output letter of the move.
+     * @return `true` if the position was solved; `false` if the budget ran out
+     *         or the board is full.
+     */
+    bool solve(Word_XO_Board* board, int& row, int& col, char& letter);
+
+    /**
+     * @brief Score of the last solved position for the side to move.
+     * @return WIN - moves for a forced win at that move count, the negative
+     *         for a forced loss, 0 for a draw.
+     */
+    int getScore() const { return score; }
+
+    static const int WIN = 100;     ///< Base score of a win (minus the letters on the board).
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = 0;       ///< Canonical position key + 1, 0 when empty.
+        int8_t value = 0;       ///< Stored score.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+        uint8_t move = 255;     ///< Best move (26 * cell + letter), a move-ordering hint only.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @brief Negamax alpha-beta search of the current cells.
+     * @return Score for the side to move.
+     */
+    int negamax(int alpha, int beta);
+
+    /**
+     * @brief Find a letter completing a word on the board.
+     * @return The move as 26 * cell + letter, or -1 if there is none.
+     */
+    int winningMove() const;
+
+    /**
+     * @brief List the safe moves, one letter per equivalence class and cell.
+     * @param moves Output array with room for 9 * 26 moves (26 * cell + letter).
+     * @return The number of moves written.
+     */
+    int safeMoves(uint8_t* moves) const;
+
+    /** @brief Symmetry-reduced key of the current cells. */
+    uint64_t canonicalKey() const;
+
+    /** @brief Build the letter classes and danger masks from the dictionary (once). */
+    static void initTables();
+
+    static uint8_t letterClass[26];         ///< Letters with equal word profiles share a class.
+    static uint8_t profileId[3][26];        ///< Class of a letter's word profile at one line position.
+    static uint32_t dangerMask[3][3][26];   ///< [new pos][other pos][other letter] -> letters leaving a completable line.
+    static bool tablesReady;                ///< initTables() has run.
+
+    int8_t cells[9];                        ///< Letter (0-25) of each cell, -1 when empty.
+    int filled = 0;                         ///< Letters on the board.
+    int score = 0;                          ///< Score of the last solved position.
+    vector<Entry> table;                    ///< Transposition table (power of two size), empty until used.
+    uint64_t tableMask;                     ///< Index mask for the table.
+    long long nodeBudget;                   ///< Node limit of one solve.
+    long long nodes = 0;                    ///< Nodes visited in the current solve.
+    bool stopped = false;                   ///< True once the budget ran out.
 };
 
 // ============================================================================
@@ -184,6 +356,8 @@ public:
     
     /**
      * @brief Determines the best move using algorithm based on the analysis of the game.
+     *
+     * Greedy heuristic used when the solver runs out of budget.
      * @param player The AI player making the move.
      * @return A tuple of integers, char {row, col, symbol} representing the optimal move.
      */
@@ -203,6 +377,8 @@ private:
     // ------------------------------------------------------------------------
     
     static std::vector<std::pair<int, char>> score[3][3];  ///< Pre-computed scores for board positions.
+
+    Word_XO_Solver solver;                                  ///< Exact search used by the AI player.
 };
 
 #endif // WORD_TIC_TAC_TOE_H
\ No newline at end of file
@@ -0,0 +1,153 @@
+#ifndef WORD_XO_DICTIONARY_H
+#define WORD_XO_DICTIONARY_H
+
+#include <cstdint>
+
+/**
+ * @file Word_XO_Dictionary.h
+ * @brief The Word Tic-Tac-Toe dictionary, embedded and preprocessed at compile time.
+ *
+ * WORD_LIST holds the words of dic.txt back to back (3 uppercase letters each);
+ * regenerate it if dic.txt changes. The word bitset and the per-position letter
+ * scores are computed from it by constexpr functions, so the game needs no file
+ * and does no parsing at startup.
+ */
+namespace Word_XO_Dictionary {
+
+/** @brief Every dictionary word, 3 letters each, no separators. */
+constexpr char WORD_LIST[] =
+    "AAHAALAASABAABOABSABYACEACTADDADOADSADZAFFAFTAGA"
+    "AGEAGOAHAAIDAILAIMAINAIRAISAITALAALBALEALLALPALS"
+    "ALTAMAAMIAMPAMUANAANDANEANIANTANYAPEAPTARBARCARE"
+    "ARFARKARMARSARTASHASKASPASSATEATTAUKAVAAVEAVOAWA"
+    "AWEAWLAWNAXEAYEAYSAZOBAABADBAGBAHBALBAMBANBAPBAR"
+    "BASBATBAYBEDBEEBEGBELBENBETBEYBIBBIDBIGBINBIOBIS"
+    "BITBIZBOABOBBODBOGBOOBOPBOSBOTBOWBOXBOYBRABROBRR"
+    "BUBBUDBUGBUMBUNBURBUSBUTBUYBYEBYSCABCADCAMCANCAP"
+    "CARCATCAWCAYCEECELCEPCHICISCOBCODCOGCOLCONCOOCOP"
+    "CORCOSCOTCOWCOXCOYCOZCRYCUBCUDCUECUMCUPCURCUTCWM"
+    "DABDADDAGDAHDAKDALDAMDAPDAWDAYDEBDEEDELDENDEVDEW"
+    "DEXDEYDIBDIDDIEDIGDIMDINDIPDISDITDOCDOEDOGDOLDOM"
+    "DONDORDOSDOTDOWDRYDUBDUDDUEDUGDUIDUNDUODUPDYEEAR"
+    "EATEAUEBBECUEDHEELEFFEFSEFTEGGEGOEKEELDELFELKELL"
+    "ELMELSEMEEMFEMSEMUENDENGENSEONERAEREERGERNERRERS"
+    "ESSETAETHEVEEWEEYEFADFAGFANFARFASFATFAXFAYFEDFEE"
+    "FEHFEMFENFERFETFEUFEWFEYFEZFIBFIDFIEFIGFILFINFIR"
+    "FITFIXFIZFLUFLYFOBFOEFOGFOHFONFOPFORFOUFOXFOYFRO"
+    "FRYFUBFUDFUGFUNFURGABGADGAEGAGGALGAMGANGAPGARGAS"
+    "GATGAYGEDGEEGELGEMGENGETGEYGHIGIBGIDGIEGIGGINGIP"
+    "GITGNUGOAGOBGODGOOGORGOTGOXGOYGULGUMGUNGUTGUVGUY"
+    "GYMGYPHADHAEHAGHAHHAJHAMHAOHAPHASHATHAWHAYHEHHEM"
+    "HENHEPHERHESHETHEWHEXHEYHICHIDHIEHIMHINHIPHISHIT"
+    "HMMHOBHODHOEHOGHONHOPHOTHOWHOYHUBHUEHUGHUHHUMHUN"
+    "HUPHUTHYPICEICHICKICYIDSIFFIFSILKILLIMPINKINNINS"
+    "IONIREIRKISMITSIVYJABJAGJAMJARJAWJAYJEEJETJEUJEW"
+    "JIBJIGJINJOBJOEJOGJOTJOWJOYJUGJUNJUSJUTKABKAEKAF"
+    "KASKATKAYKEAKEFKEGKENKEPKEXKEYKHIKIDKIFKINKIPKIR"
+    "KITKOAKOBKOIKOPKORKOSKUELABLACLADLAGLAMLAPLARLAS"
+    "LATLAVLAWLAXLAYLEALEDLEELEGLEILEKLETLEULEVLEXLEY"
+    "LEZLIBLIDLIELINLIPLISLITLOBLOGLOOLOPLOTLOWLOXLUG"
+    "LUMLUVLUXLYEMACMADMAEMAGMANMAPMARMASMATMAWMAXMAY"
+    "MEDMELMEMMENMETMEWMHOMIBMIDMIGMILMIMMIRMISMIXMOA"
+    "MOBMOCMODMOGMOLMOMMONMOOMOPMORMOSMOTMOWMUDMUGMUM"
+    "MUNMUSMUTNABNAENAGNAHNAMNANNAPNAWNAYNEBNEENETNEW"
+    "NIBNILNIMNIPNITNIXNOBNODNOGNOHNOMNOONORNOSNOTNOW"
+    "NTHNUBNUNNUSNUTOAFOAKOAROATOBEOBIOCAODDODEODSOES"
+    "OFFOFTOHMOHOOHSOILOKAOKEOLDOLEOMSONEONSOOHOOTOPE"
+    "OPSOPTORAORBORCOREORSORTOSEOUDOUROUTOVAOWEOWLOWN"
+    "OXOOXYPACPADPAHPALPAMPANPAPPARPASPATPAWPAXPAYPEA"
+    "PECPEDPEEPEGPEHPENPEPPERPESPETPEWPHIPHTPIAPICPIE"
+    "PIGPINPIPPISPITPIUPIXPLYPODPOHPOIPOLPOMPOPPOTPOW"
+    "POXPROPRYPSIPUBPUDPUGPULPUNPUPPURPUSPUTPYAPYEPYX"
+    "QATQUARADRAGRAHRAJRAMRANRAPRASRATRAWRAXRAYREBREC"
+    "REDREEREFREGREIREMREPRESRETREVREXRHORIARIBRIDRIF"
+    "RIGRIMRINRIPROBROCRODROEROMROTROWRUBRUERUGRUMRUN"
+    "RUTRYARYESABSACSADSAESAGSALSAPSATSAUSAWSAXSAYSEA"
+    "SECSEESEGSEISELSENSERSETSEWSEXSHASHESHHSHYSIBSIC"
+    "SIMSINSIPSIRSISSITSIXSKASKISKYSLYSOBSODSOLSONSOP"
+    "SOSSOTSOUSOWSOXSOYSPASPYSRISTYSUBSUESUMSUNSUPSUQ"
+    "SYNTABTADTAETAGTAJTAMTANTAOTAPTARTASTATTAUTAVTAW"
+    "TAXTEATEDTEETEGTELTENTETTEWTHETHOTHYTICTIETILTIN"
+    "TIPTISTITTODTOETOGTOMTONTOOTOPTORTOTTOWTOYTRYTSK"
+    "TUBTUGTUITUNTUPTUTTUXTWATWOTYEUDOUGHUKEULUUMMUMP"
+    "UNSUPOUPSURBURDURNUSEUTAUTSVACVANVARVASVATVAUVAV"
+    "VAWVEEVEGVETVEXVIAVIEVIGVIMVISVOEVOWVOXVUGWABWAD"
+    "WAEWAGWANWAPWARWASWATWAWWAXWAYWEBWEDWEEWENWETWHA"
+    "WHOWHYWIGWINWISWITWIZWOEWOGWOKWONWOOWOPWOSWOTWOW"
+    "WRYWUDWYEWYNXISYAHYAKYAMYAPYARYAWYAYYEAYEHYENYEP"
+    "YESYETYEWYIDYINYIPYOBYODYOKYOMYONYOUYOWYUKYUMYUP"
+    "ZAGZAPZAXZEDZEEZEKZIGZINZIPZITZOAZOO";
+
+constexpr int WORD_COUNT = (sizeof(WORD_LIST) - 1) / 3;     ///< Number of words in WORD_LIST.
+constexpr int WORDS = 26 * 26 * 26;                         ///< Number of letter triples.
+
+/**
+ * @brief Dictionary as a 26^3-bit set, bit 676 * a + 26 * b + c for word "abc".
+ */
+struct Bits {
+    uint64_t word[(WORDS + 63) / 64] = {};
+};
+
+/**
+ * @brief Letter scores of each line position, best letter first.
+ *
+ * The score of a letter at a position is the number of distinct letters that
+ * appear at the other two positions of words having it there. Positions are
+ * 0 (corner cells), 1 (center) and 2 (edge cells), as in Word_XO_UI::evaluate.
+ */
+struct Scores {
+    int score[3][26] = {};
+    char letter[3][26] = {};
+};
+
+/** @brief Build the word bitset from WORD_LIST. */
+constexpr Bits buildBits()
+{
+    Bits bits;
+    for (int i = 0; i < WORD_COUNT; ++i) {
+        int w = (WORD_LIST[3 * i] - 'A') * 676 + (WORD_LIST[3 * i + 1] - 'A') * 26 + (WORD_LIST[3 * i + 2] - 'A');
+        bits.word[w / 64] |= uint64_t(1) << (w % 64);
+    }
+    return bits;
+}
+
+/** @brief Build the sorted letter scores from WORD_LIST. */
+constexpr Scores buildScores()
+{
+    Scores scores;
+    for (int p = 0; p < 3; ++p) {
+        // Letters seen at the two other positions, per letter at position p
+        uint32_t seen[26][2] = {};
+        for (int i = 0; i < WORD_COUNT; ++i) {
+            int l = WORD_LIST[3 * i + p] - 'A';
+            int other = 0;
+            for (int k = 0; k < 3; ++k)
+                if (k != p) seen[l][other++] |= uint32_t(1) << (WORD_LIST[3 * i + k] - 'A');
+        }
+
+        // Insertion sort, descending by (score, letter) like sorting the pairs in reverse
+        for (int l = 0; l < 26; ++l) {
+            int s = 0;
+            for (int k = 0; k < 2; ++k)
+                for (uint32_t m = seen[l][k]; m; m &= m - 1) ++s;
+
+            int j = l;
+            while (j > 0 && (scores.score[p][j - 1] < s ||
+                             (scores.score[p][j - 1] == s && scores.letter[p][j - 1] < 'A' + l))) {
+                scores.score[p][j] = scores.score[p][j - 1];
+                scores.letter[p][j] = scores.letter[p][j - 1];
+                --j;
+            }
+            scores.score[p][j] = s;
+            scores.letter[p][j] = char('A' + l);
+        }
+    }
+    return scores;
+}
+
+constexpr Bits BITS = buildBits();         ///< The embedded dictionary.
+constexpr Scores SCORES = buildScores();   ///< Letter scores of the embedded dictionary.
+
+} // namespace Word_XO_Dictionary
+
+#endif // WORD_XO_DICTIONARY_H
@@ -2,8 +2,9 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype>  // for toupper()
-#include <queue>
+#include <algorithm>
 #include "XO_inf.h"
+#include "../../header/Random.h"
 
 using namespace std;
 
@@ -14,6 +15,50 @@ XO_inf_Board::XO_inf_Board() : Board(3, 3) {
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
+    seen[position] = 1;
+}
+
+uint16_t XO_inf_Board::marks(uint32_t pos, int player) {
+    uint16_t mask = 0;
+    for (int i = 0; i < count(pos, player); ++i)
+        mask |= 1 << cell(pos, player, i);
+    return mask;
+}
+
+bool XO_inf_Board::has_line(uint16_t marks) {
+    static const uint16_t LINES[8] = {0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124};
+    for (uint16_t line : LINES)
+        if ((marks & line) == line) return true;
+    return false;
+}
+
+uint32_t XO_inf_Board::play(uint32_t pos, int cell) {
+    int player = side(pos);
+    int shift = 14 * player;
+    uint32_t half = (pos >> shift) & 0x3FFF;
+    uint32_t n = half & 3, cells = half >> 2;
+
+    // Append the new mark; a fourth one pushes out the oldest
+    if (n < 3) cells |= uint32_t(cell) << (4 * n++);
+    else       cells = (cells >> 4) | (uint32_t(cell) << 8);
+
+    pos = (pos & ~(0x3FFFu << shift)) | ((n | cells << 2) << shift);
+    return pos ^ (1u << 28);
+}
+
+void XO_inf_Board::sync() {
+    for (int c = 0; c < 9; ++c) board[c / 3][c % 3] = blank_symbol;
+    for (int p = 0; p < 2; ++p)
+        for (int i = 0; i < count(position, p); ++i) {
+            int c = cell(position, p, i);
+            board[c / 3][c % 3] = p == 0 ? 'X' : 'O';
+        }
+    n_moves = count(position, 0) + count(position, 1);
+}
+
+int XO_inf_Board::repetitions() const {
+    auto it = seen.find(position);
+    return it == seen.end() ? 0 : it->second;
 }
 
 bool XO_inf_Board::update_board(Move<char>* move) {
@@ -21,67 +66,163 @@ bool XO_inf_Board::update_board(Move<char>* move) {
     int y = move->get_y();
     char mark = move->get_symbol();
 
-    // Validate move and apply if valid
-    if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0)) {
-        if (mark == 'X') {
-            history1.push({ x, y });
-            if (history1.size() > 3) {
-                n_moves--;
-                board[history1.front().first][history1.front().second] = blank_symbol;
-                history1.pop();
-            }
-        }
-        else if (mark == 'O') {
-            history2.push({ x, y });
-            if (history2.size() > 3) {
-                n_moves--;
-                board[history2.front().first][history2.front().second] = blank_symbol;
-                history2.pop();
-            }
-        }
-        if (mark == 0) { // Undo move
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else {         // Apply move
-            n_moves++;
-            board[x][y] = toupper(mark);
+    if (x < 0 || x >= rows || y < 0 || y >= columns) return false;
+    int c = 3 * x + y;
 
-        }
-        return true;
+    if (mark == 0) { // Undo: only the newest mark can be taken back
+        if (past.empty()) return false;
+        int mover = 1 - side(position);
+        if (cell(position, mover, count(position, mover) - 1) != c) return false;
+
+        if (--seen[position] == 0) seen.erase(position);
+        position = past.back();
+        past.pop_back();
     }
-    return false;
+    else {           // Apply move
+        if (board[x][y] != blank_symbol) return false;
+
+        // The mark decides who moves, even if the turn order was broken
+        int player = toupper(mark) == 'X' ? 0 : 1;
+        past.push_back(position);
+        position = play((position & ~(1u << 28)) | (uint32_t(player) << 28), c);
+        ++seen[position];
+    }
+    sync();
+    return true;
 }
 
 bool XO_inf_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
+    return has_line(marks(position, toupper(player->get_symbol()) == 'X' ? 0 : 1));
+}
 
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
+bool XO_inf_Board::is_draw(Player<char>* player) {
+    return repetitions() >= 3 && !is_win(player);
+}
 
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
+bool XO_inf_Board::game_is_over(Player<char>* player) {
+    return is_win(player) || is_draw(player);
+}
+
+//--------------------------------------- XO_inf_Solver Implementation
+
+int8_t XO_inf_Solver::results[XO_inf_Solver::STATES];
+uint8_t XO_inf_Solver::plies[XO_inf_Solver::STATES];
+bool XO_inf_Solver::built = false;
+
+int XO_inf_Solver::index(uint32_t pos) {
+    int idx = 0;
+    for (int p = 0; p < 2; ++p)
+        for (int i = 0; i < 3; ++i)
+            idx = idx * 10 + (i < XO_inf_Board::count(pos, p) ? XO_inf_Board::cell(pos, p, i) : 9);
+    return idx * 2 + XO_inf_Board::side(pos);
+}
+
+/// True if the player who just moved has three in a row (the game is over).
+static bool finished(uint32_t pos) {
+    return XO_inf_Board::has_line(XO_inf_Board::marks(pos, 1 - XO_inf_Board::side(pos)));
+}
+
+/// Empty cells of a position as a 9-bit mask.
+static uint16_t empty_cells(uint32_t pos) {
+    return 0x1FF & ~(XO_inf_Board::marks(pos, 0) | XO_inf_Board::marks(pos, 1));
+}
+
+void XO_inf_Solver::build() {
+    if (built) return;
+    for (auto& r : results) r = UNREACHED;
+
+    // 1. Every position reachable from the empty board, X to move
+    vector<uint32_t> nodes{0};
+    vector<int32_t> id(STATES, -1);
+    id[index(0)] = 0;
+    results[index(0)] = 0;
+    for (size_t k = 0; k < nodes.size(); ++k) {
+        if (finished(nodes[k])) continue;
+        for (uint16_t e = empty_cells(nodes[k]); e; e &= e - 1) {
+            uint32_t child = XO_inf_Board::play(nodes[k], __builtin_ctz(e));
+            int i = index(child);
+            if (id[i] >= 0) continue;
+            id[i] = int32_t(nodes.size());
+            results[i] = 0;
+            nodes.push_back(child);
+        }
     }
 
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
+    // 2. Predecessor lists, and how many moves of each position are still undecided
+    size_t n = nodes.size();
+    vector<int32_t> remaining(n, 0), start(n + 1, 0);
+    for (size_t k = 0; k < n; ++k) {
+        if (finished(nodes[k])) continue;
+        for (uint16_t e = empty_cells(nodes[k]); e; e &= e - 1) {
+            ++remaining[k];
+            ++start[id[index(XO_inf_Board::play(nodes[k], __builtin_ctz(e)))] + 1];
+        }
+    }
+    for (size_t k = 0; k < n; ++k) start[k + 1] += start[k];
+    vector<int32_t> preds(start[n]), fill(start.begin(), start.end() - 1);
+    for (size_t k = 0; k < n; ++k) {
+        if (finished(nodes[k])) continue;
+        for (uint16_t e = empty_cells(nodes[k]); e; e &= e - 1)
+            preds[fill[id[index(XO_inf_Board::play(nodes[k], __builtin_ctz(e)))]]++] = int32_t(k);
+    }
 
-    return false;
+    // 3. Retrograde analysis, nearest endings first: a move into a lost position
+    //    wins; a position whose every move reaches a won one is lost
+    vector<int32_t> work;
+    for (size_t k = 0; k < n; ++k)
+        if (finished(nodes[k])) {
+            results[index(nodes[k])] = -1;
+            plies[index(nodes[k])] = 0;
+            work.push_back(int32_t(k));
+        }
+    for (size_t w = 0; w < work.size(); ++w) {
+        int v = index(nodes[work[w]]);
+        for (int32_t j = start[work[w]]; j < start[work[w] + 1]; ++j) {
+            int32_t k = preds[j];
+            int p = index(nodes[k]);
+            if (results[p] != 0) continue;
+
+            if (results[v] == -1 || --remaining[k] == 0) {
+                results[p] = results[v] == -1 ? 1 : -1;
+                plies[p] = uint8_t(std::min(255, plies[v] + 1));
+                work.push_back(k);
+            }
+        }
+    }
+    built = true;
 }
 
-bool XO_inf_Board::is_draw(Player<char>* player) {
-    return (n_moves == 9 && !is_win(player));
+int XO_inf_Solver::value(uint32_t pos) {
+    build();
+    int r = results[index(pos)];
+    return r == UNREACHED ? 0 : r;
 }
 
-bool XO_inf_Board::game_is_over(Player<char>* player) {
-    return is_win(player) || is_draw(player);
+int XO_inf_Solver::distance(uint32_t pos) {
+    build();
+    return value(pos) == 0 ? 0 : plies[index(pos)];
+}
+
+int XO_inf_Solver::best_move(uint32_t pos) {
+    build();
+    if (results[index(pos)] == UNREACHED || finished(pos)) return -1;
+
+    // Rank moves by result, then by speed: win fast, lose slowly; ties at random
+    int best = -1, bestScore = 0, ties = 0;
+    for (uint16_t e = empty_cells(pos); e; e &= e - 1) {
+        int c = __builtin_ctz(e);
+        int child = index(XO_inf_Board::play(pos, c));
+        int r = -results[child];
+        int score = r == 1 ? 1000 - plies[child] : r == -1 ? -1000 + plies[child] : 0;
+
+        if (best < 0 || score > bestScore) {
+            best = c, bestScore = score, ties = 1;
+        }
+        else if (score == bestScore && Random::local().below(++ties) == 0) {
+            best = c;
+        }
+    }
+    return best;
 }
 
 //--------------------------------------- XO_UI Implementation
@@ -104,8 +245,11 @@ Move<char>* XO_inf_UI::get_move(Player<char>* player) {
         cin >> x >> y;
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        // Perfect play is a table lookup; a position the table lacks gets a random cell
+        auto* board = static_cast<XO_inf_Board*>(player->get_board_ptr());
+        int c = XO_inf_Solver::best_move(board->get_position());
+        if (c < 0) c = Random::local().below(9);
+        x = c / 3, y = c % 3;
     }
     return new Move<char>(x, y, player->get_symbol());
 }
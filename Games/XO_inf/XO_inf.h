@@ -1,14 +1,33 @@
 #ifndef XO_inf_H
-#define X_inf_H
-#include <queue>
+#define XO_inf_H
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 #include "../../header/BoardGame_Classes.h"
 using namespace std;
 
+/**
+ * @brief Infinite XO: each player keeps at most three marks, a fourth removes their oldest.
+ *
+ * The whole position is one packed integer: per player a 2-bit mark count
+ * and three 4-bit cells (3 * row + col), oldest first, with X in bits 0-13,
+ * O in bits 14-27 and the side to move (0 X, 1 O) in bit 28. Playing a move
+ * is a few shifts and taking it back restores the previous integer, so both
+ * are O(1); the 3x3 matrix is kept in sync for display only.
+ *
+ * Marks come and go, so the game can run forever: a position that occurs
+ * for the third time (same marks, same order, same side to move) is a draw.
+ */
 class XO_inf_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
-    queue<pair<int, int>> history1;
-    queue<pair<int, int>> history2;
+    uint32_t position = 0;                  ///< Packed position (see the class description).
+    vector<uint32_t> past;                  ///< Position before each move, for undo.
+    unordered_map<uint32_t, int> seen;      ///< Occurrences of every position of this game.
+
+    /** @brief Rewrite the display matrix from the packed position. */
+    void sync();
+
 public:
 
     XO_inf_Board();
@@ -17,6 +36,82 @@ public:
     bool is_lose(Player<char>*) { return false; };
     bool is_draw(Player<char>* player);
     bool game_is_over(Player<char>* player);
+
+    /** @brief The packed position. */
+    uint32_t get_position() const { return position; }
+
+    /** @brief Times the current position has occurred, this time included. */
+    int repetitions() const;
+
+    /** @brief Side to move of a position: 0 for X, 1 for O. */
+    static int side(uint32_t pos) { return (pos >> 28) & 1; }
+
+    /** @brief Number of marks a player (0 X, 1 O) has on the board. */
+    static int count(uint32_t pos, int player) { return (pos >> (14 * player)) & 3; }
+
+    /** @brief The i-th oldest mark of a player. */
+    static int cell(uint32_t pos, int player, int i) { return (pos >> (14 * player + 2 + 4 * i)) & 15; }
+
+    /** @brief A player's marks as a 9-bit cell mask. */
+    static uint16_t marks(uint32_t pos, int player);
+
+    /** @brief True if a 9-bit cell mask holds three in a row. */
+    static bool has_line(uint16_t marks);
+
+    /**
+     * @brief The position after the side to move marks a cell.
+     * @param pos The position.
+     * @param cell An empty cell (3 * row + col).
+     */
+    static uint32_t play(uint32_t pos, int cell);
+};
+
+
+/**
+ * @brief Perfect play for Infinite XO.
+ *
+ * Every position reachable from the empty board (about 10^5) is solved
+ * once, on first use, by retrograde analysis: the mover's three in a row
+ * ends the game, a position is lost once every move leads to a win for the
+ * opponent, and whatever is never decided can be held forever, a draw.
+ * Results are kept with the distance to the end of the game, so the winner
+ * takes the fastest win and the loser the slowest loss.
+ *
+ * A position is indexed by its mark sequences (one digit per mark, 9 for
+ * none) and side to move, so a lookup is a few multiplications.
+ */
+class XO_inf_Solver {
+public:
+    static const int STATES = 2000000;      ///< 1000 X sequences * 1000 O sequences * 2 sides.
+
+    /**
+     * @brief Best cell for the side to move.
+     * @param pos Packed position (see XO_inf_Board).
+     * @return The cell as 3 * row + col, or -1 if the game is over or the position is unreachable.
+     */
+    static int best_move(uint32_t pos);
+
+    /**
+     * @brief Result with perfect play for the side to move.
+     * @return 1 win, 0 draw, -1 loss.
+     */
+    static int value(uint32_t pos);
+
+    /** @brief Moves left until the end of a won or lost game, 0 otherwise. */
+    static int distance(uint32_t pos);
+
+    /** @brief Table index of a position. */
+    static int index(uint32_t pos);
+
+private:
+    /** @brief Solve every position reachable from the empty board (once). */
+    static void build();
+
+    static const int8_t UNREACHED = -2;     ///< Marks positions the game cannot reach.
+
+    static int8_t results[STATES];          ///< 1 win, 0 draw, -1 loss for the side to move.
+    static uint8_t plies[STATES];           ///< Moves until the end of a decided game.
+    static bool built;                      ///< build() has run.
 };
 
 
@@ -35,5 +130,4 @@ public:
     virtual Move<char>* get_move(Player<char>* player);
 };
 
-#endif 
-
+#endif
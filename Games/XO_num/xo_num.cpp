@@ -2,6 +2,14 @@
 #include <iomanip>
 #include <cctype>
 #include "xo_num.h"
+#include "../../header/Random.h"
+#include "../../header/Symmetry.h"
+
+const uint8_t XO_NUM_Board::CELL_LINES[9][5] = {
+    {3, 0, 3, 6}, {2, 0, 4}, {3, 0, 5, 7},
+    {2, 1, 3},    {4, 1, 4, 6, 7}, {2, 1, 5},
+    {3, 2, 3, 7}, {2, 2, 4}, {3, 2, 5, 6}
+};
 
 XO_NUM_Board::XO_NUM_Board() : Board(3, 3)
 {
@@ -11,63 +19,187 @@ XO_NUM_Board::XO_NUM_Board() : Board(3, 3)
             cell = blank_symbol;
 }
 
+void XO_NUM_Board::play(int cell, int digit)
+{
+    cells |= uint64_t(digit) << (4 * cell);
+    used |= 1 << digit;
+    for (int i = 1; i <= CELL_LINES[cell][0]; ++i)
+    {
+        int line = CELL_LINES[cell][i];
+        lineSum[line] += digit;
+        if (++lineCount[line] == 3 && lineSum[line] == 15)
+            fullLines15++;
+    }
+    board[cell / 3][cell % 3] = char('0' + digit);
+    n_moves++;
+}
+
+void XO_NUM_Board::undo(int cell)
+{
+    int digit = digit_at(cell);
+    for (int i = 1; i <= CELL_LINES[cell][0]; ++i)
+    {
+        int line = CELL_LINES[cell][i];
+        if (lineCount[line]-- == 3 && lineSum[line] == 15)
+            fullLines15--;
+        lineSum[line] -= digit;
+    }
+    cells &= ~(uint64_t(15) << (4 * cell));
+    used &= ~(1 << digit);
+    board[cell / 3][cell % 3] = blank_symbol;
+    n_moves--;
+}
+
+uint16_t XO_NUM_Board::empty_cells() const
+{
+    uint16_t mask = 0;
+    for (int c = 0; c < 9; ++c)
+        if (digit_at(c) == 0) mask |= 1 << c;
+    return mask;
+}
+
 bool XO_NUM_Board::update_board(Move<char> *move)
 {
     int x = move->get_x();
     int y = move->get_y();
     char mark = move->get_symbol();
 
-    // Validate move and apply if valid
-    if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0))
-    {
+    if (x < 0 || x >= rows || y < 0 || y >= columns)
+        return false;
 
-        if (mark == 0)
-        { // Undo move
-            n_moves--;
-            board[x][y] = blank_symbol;
-        }
-        else
-        { // Apply move
-            n_moves++;
-            board[x][y] = toupper(mark);
-        }
+    int cell = 3 * x + y;
+    if (mark == 0)
+    { // Undo move
+        if (digit_at(cell) != 0) undo(cell);
         return true;
     }
-    return false;
+
+    // The digit must be one the side to move still holds, and the cell empty
+    int digit = mark - '0';
+    if (digit < 1 || digit > 9 || !(remaining() >> digit & 1) || digit_at(cell) != 0)
+        return false;
+
+    play(cell, digit);
+    return true;
+}
+
+bool XO_NUM_Board::is_win(Player<char> * /*player*/)
+{
+    return has_fifteen();
 }
 
-bool XO_NUM_Board::is_win(Player<char> *player)
+bool XO_NUM_Board::is_draw(Player<char> * /*player*/)
 {
+    return (n_moves == 9 && !has_fifteen());
+}
 
- 
+bool XO_NUM_Board::game_is_over(Player<char> *player)
+{
+    return is_win(player) || is_draw(player);
+}
 
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i)
-    {
-        if ((board[i][0]-'0'+board[i][1]-'0'+ board[i][2]-'0'==15) ||
-            (board[0][i]-'0'+ board[1][i]-'0'+ board[2][i]-'0'==15 ))
-            return true;
-    }
+//--------------------------------------- XO_NUM_Solver Implementation
 
-    // Check diagonals
-    if (((board[0][0]-'0'+ board[1][1]-'0'+board[2][2]-'0')== 15) ||((board[0][2]-'0'+ board[1][1]-'0'+ board[2][0]-'0')==15))
-        return true;
+XO_NUM_Solver::XO_NUM_Solver(int tableBits) : tableMask((uint64_t(1) << tableBits) - 1) {}
 
+bool XO_NUM_Solver::can_win_now(const XO_NUM_Board& b)
+{
+    uint16_t digits = b.remaining();
+    for (int line = 0; line < 8; ++line)
+    {
+        if (b.line_count(line) != 2) continue;
+        int need = 15 - b.line_sum(line);
+        if (need >= 1 && need <= 9 && (digits >> need & 1)) return true;
+    }
     return false;
 }
 
-bool XO_NUM_Board::is_draw(Player<char> *player)
+int XO_NUM_Solver::negamax(XO_NUM_Board& b, int alpha, int beta)
 {
-    return (n_moves == 9 && !is_win(player));
+    int moves = b.get_moves();
+    if (can_win_now(b)) return WIN - (moves + 1);
+    if (moves == 9) return 0;
+
+    // No immediate win: the best this side can do is win on its next turn
+    int ceiling = WIN - (moves + 3);
+    if (ceiling <= alpha) return ceiling;
+    if (beta > ceiling) beta = ceiling;
+
+    int transform;
+    uint64_t key = Symmetry<3, 4>::canonical(b.get_cells(), transform) + 1;
+    Entry& e = table[(key * 0x9E3779B97F4A7C15ULL >> 20) & tableMask];
+    if (e.key == key)
+    {
+        if (e.bound == EXACT) return e.value;
+        if (e.bound == LOWER && e.value >= beta) return e.value;
+        if (e.bound == UPPER && e.value <= alpha) return e.value;
+    }
+
+    int alphaOrig = alpha;
+    int best = -WIN;
+    uint16_t empty = b.empty_cells();
+    uint16_t digits = b.remaining();
+
+    for (int cell = 0; cell < 9 && best < beta; ++cell)
+    {
+        if (!(empty >> cell & 1)) continue;
+        for (int d = 1; d <= 9; ++d)
+        {
+            if (!(digits >> d & 1)) continue;
+            b.play(cell, d);
+            int v = -negamax(b, -beta, -alpha);
+            b.undo(cell);
+
+            if (v > best) best = v;
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) break;
+        }
+    }
+
+    e.key = key;
+    e.value = int8_t(best);
+    e.bound = best <= alphaOrig ? UPPER : best >= beta ? LOWER : EXACT;
+    return best;
 }
 
-bool XO_NUM_Board::game_is_over(Player<char> *player)
+bool XO_NUM_Solver::best_move(const XO_NUM_Board& board, int& cell, int& digit)
 {
-    return is_win(player) || is_draw(player);
-}
+    if (board.has_fifteen() || board.get_moves() == 9) return false;
+    if (table.empty()) table.resize(tableMask + 1);
 
+    XO_NUM_Board b(board);
+    uint16_t empty = b.empty_cells();
+    uint16_t digits = b.remaining();
+    vector<pair<int, int>> best;
+    score = -WIN - 1;
 
+    // Every root move gets its exact value so that ties can be broken at random
+    for (int c = 0; c < 9; ++c)
+    {
+        if (!(empty >> c & 1)) continue;
+        for (int d = 1; d <= 9; ++d)
+        {
+            if (!(digits >> d & 1)) continue;
+            b.play(c, d);
+            int v = b.has_fifteen() ? WIN - b.get_moves() : -negamax(b, -WIN, 1 - score);
+            b.undo(c);
+
+            if (v > score)
+            {
+                score = v;
+                best.clear();
+            }
+            if (v == score) best.push_back({c, d});
+        }
+    }
+
+    auto choice = best[Random::local().below(best.size())];
+    cell = choice.first;
+    digit = choice.second;
+    return true;
+}
+
+//--------------------------------------- XO_NUM_UI Implementation
 
  XO_NUM_UI::XO_NUM_UI() : UI<char>("Numerical Tic-Tac-Toe", 3) {}
 Player<char>**XO_NUM_UI::setup_players() {
@@ -89,77 +221,35 @@ Player<char> *XO_NUM_UI::create_player(string &name, char symbol, PlayerType typ
 }
 
 Move<char> *XO_NUM_UI::get_move(Player<char> *player)
-{ 
-    int x, y,index;
+{
+    int x, y;
+    char num = 0;
+    auto* board = static_cast<XO_NUM_Board*>(player->get_board_ptr());
+    uint16_t digits = board->remaining();
 
     if (player->get_type() == PlayerType::HUMAN)
     {
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
-        // ask user to enter his choice
+        // player 1 holds the odd numbers, player 2 the even ones; each is used once
         cout<<"\n Please enter your num\n";
-        if (player->get_symbol()=='2'  && !even.empty()){
-              for (char x : even){
-               cout <<x << " ";
-            }
-        }
-        else if (player->get_symbol()=='1'  && !odd.empty()){
-              for (char x : odd)
-               cout << x << " "; 
-            }
+        for (int d = 1; d <= 9; ++d)
+            if (digits >> d & 1) cout << d << " ";
         cin>>num;
-        // this func checks user choice and removes it from vector if valid
-      auto exist = [](vector<char>& v, char n) -> bool {
-        for (auto it = v.begin(); it != v.end(); ) {
-            if (*it == n){
-                v.erase(it);
-              return true;
-            }
-            ++it; 
-        }
-        return false;
-    };
-    // if player 1->odd numbers  player2 ->even
-
-      if (player->get_symbol()=='2'){
-        while ( !exist(even,num)){
+        while (num < '1' || num > '9' || !(digits >> (num - '0') & 1)) {
             cout<<"Please choose from your numbers\n";
-              for (char x : even){
-               cout <<x << " ";
-              }
-             cin>>num;
+            for (int d = 1; d <= 9; ++d)
+                if (digits >> d & 1) cout << d << " ";
+            cin>>num;
         }
-      }
-       else if (player->get_symbol()=='1'){
-       while (!exist(odd,num) ){
-            cout<<"Please choose from your numbers\n";
-              for (char x : odd){
-               cout << x << " ";
-              }
-             cin>>num;
-        }
-      }
-        
     }
     else if (player->get_type() == PlayerType::COMPUTER)
     {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
-        if (player->get_symbol()=='2'  && !even.empty()){
-            // random choice by index
-              index =rand() % even.size();
-              num=even[index];
-              even.erase(even.begin() + index);
-            
-        }
-       else if (player->get_symbol()=='1' && !odd.empty()){
-              index =rand() % odd.size();
-              num=odd[index];
-              odd.erase(odd.begin() + index);
-        }
-       
-           
-   
+        // Perfect play from the exact solver
+        int cell = 0, digit = 0;
+        solver.best_move(*board, cell, digit);
+        x = cell / 3, y = cell % 3;
+        num = char('0' + digit);
     }
     return new Move<char>(x, y, num);
 }
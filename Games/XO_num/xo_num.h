@@ -2,16 +2,36 @@
 #define XO_num_H
 
 #include "../../header/BoardGame_Classes.h"
+#include <cstdint>
 #include <vector>
 using namespace std;
 
 
+/**
+ * @brief Numerical Tic-Tac-Toe: player 1 places the odd digits, player 2 the even ones,
+ *        each digit once; a full line summing to 15 wins.
+ *
+ * Besides the display matrix the board keeps a packed state: the digit of
+ * every cell (4 bits per cell, cell 3 * row + col, 0 for empty), a mask of
+ * the digits already used, and for every line its running sum and digit
+ * count. play() and undo() update only the lines through the cell, so a
+ * win check is a single comparison.
+ */
 class XO_NUM_Board : public Board<char> {
 private:
-    char blank_symbol = '.'; 
- 
+    char blank_symbol = '.';
+
+    uint64_t cells = 0;         ///< Digit of each cell, 4 bits per cell.
+    uint16_t used = 0;          ///< Digits on the board (bit d for digit d).
+    int8_t lineSum[8] {};       ///< Sum of the digits on each line.
+    uint8_t lineCount[8] {};    ///< Number of digits on each line.
+    int fullLines15 = 0;        ///< Full lines summing to 15.
+
 public:
-   
+    static const uint16_t ODD = 0x2AA;      ///< Digits 1, 3, 5, 7, 9.
+    static const uint16_t EVEN = 0x154;     ///< Digits 2, 4, 6, 8.
+    static const uint8_t CELL_LINES[9][5];  ///< Lines through each cell (rows 0-2, columns 3-5, diagonals 6-7): count, then line indexes.
+
     XO_NUM_Board();
 
     bool update_board(Move<char>* move) override;
@@ -19,23 +39,111 @@ public:
     bool is_lose(Player<char>* player) { return false; }
     bool is_draw(Player<char>* player) override;
     bool game_is_over(Player<char>* player) override;
-  
+
+    /**
+     * @brief Place a digit without any checks (the cell must be empty, the digit unused).
+     * @param cell Cell index (3 * row + col).
+     * @param digit Digit 1-9.
+     */
+    void play(int cell, int digit);
+
+    /** @brief Take the digit off a cell, reversing play(). */
+    void undo(int cell);
+
+    /** @brief Digit on a cell, 0 if empty. */
+    int digit_at(int cell) const { return int(cells >> (4 * cell)) & 15; }
+
+    /** @brief All cells packed 4 bits per cell. */
+    uint64_t get_cells() const { return cells; }
+
+    /** @brief Digits still available to the side to move (odd moves first). */
+    uint16_t remaining() const { return (n_moves % 2 == 0 ? ODD : EVEN) & ~used; }
+
+    /** @brief Empty cells as a 9-bit mask. */
+    uint16_t empty_cells() const;
+
+    /** @brief Number of digits on the board. */
+    int get_moves() const { return n_moves; }
+
+    /** @brief Running sum of a line. */
+    int line_sum(int line) const { return lineSum[line]; }
+
+    /** @brief Number of digits on a line. */
+    int line_count(int line) const { return lineCount[line]; }
+
+    /** @brief True if some full line sums to 15. */
+    bool has_fifteen() const { return fullLines15 > 0; }
+};
+
+
+/**
+ * @brief Exact solver for Numerical Tic-Tac-Toe.
+ *
+ * Negamax with alpha-beta over (cell, digit) moves, searched to the end of
+ * the game. A line holding two digits whose missing third one is still in
+ * the mover's hand is an immediate win, found before any move is tried.
+ * Results are cached in a transposition table keyed by the cells (the digit
+ * masks follow from them), reduced over the 8 board symmetries. The table
+ * is kept between moves, so after the first search answers are lookups.
+ */
+class XO_NUM_Solver {
+public:
+    static const int WIN = 100;     ///< Score of a win, minus the digits on the board when it happens.
+
+    /**
+     * @brief Construct the solver; the table is allocated on the first search.
+     * @param tableBits log2 of the number of table entries.
+     */
+    explicit XO_NUM_Solver(int tableBits = 20);
+
+    /**
+     * @brief Find a best move for the side to move (ties broken at random).
+     * @param board The position (left unchanged).
+     * @param cell Receives the cell (3 * row + col).
+     * @param digit Receives the digit.
+     * @return false if the game is already over.
+     */
+    bool best_move(const XO_NUM_Board& board, int& cell, int& digit);
+
+    /** @brief Score of the last best_move() for the side that moved. */
+    int get_score() const { return score; }
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = 0;       ///< Canonical cells + 1, 0 when empty.
+        int8_t value = 0;       ///< Stored score.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /** @brief Negamax alpha-beta search to the end of the game; score for the side to move. */
+    int negamax(XO_NUM_Board& b, int alpha, int beta);
+
+    /** @brief True if the side to move can complete a line of 15 right now. */
+    static bool can_win_now(const XO_NUM_Board& b);
+
+    vector<Entry> table;            ///< Transposition table (power of two size).
+    uint64_t tableMask;             ///< Index mask for the table.
+    int score = 0;                  ///< Result of the last search.
 };
 
 
 
 class XO_NUM_UI : public UI<char> {
+private:
+    XO_NUM_Solver solver;       ///< Perfect play for the computer player.
 public:
 
     XO_NUM_UI();
 
     ~XO_NUM_UI() {};
-   char num;
-   vector<char> odd{'1','3','5','7','9'}; 
-   vector<char> even{'2','4','6','8'}; 
    Player<char>* create_player(string& name,char symbol, PlayerType type) override ;
    Player<char>** setup_players() override ;
    Move<char>* get_move(Player<char>* player) override;
 };
 
-#endif 
+#endif
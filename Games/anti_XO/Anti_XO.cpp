@@ -1,4 +1,6 @@
 #include "Anti_XO.h"
+#include "../../header/Random.h"
+#include "../../header/Symmetry.h"
 using namespace std;
 
 
@@ -7,6 +9,14 @@ Anti_XO_Board::Anti_XO_Board():Board(3,3)
     board.assign(3, vector<char>(3, '.'));
 }
 
+bool Anti_XO_Board::has_line(uint16_t marks)
+{
+    static const uint16_t LINES[8] = {0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124};
+    for (uint16_t line : LINES)
+        if ((marks & line) == line) return true;
+    return false;
+}
+
 bool Anti_XO_Board::update_board(Move<char>* move)
 {
     int r = move->get_x();
@@ -16,45 +26,35 @@ bool Anti_XO_Board::update_board(Move<char>* move)
     if (r < 0 || r >= 3 || c < 0 || c >= 3)
         return false;
 
+    if (s == 0) { // Undo move
+        if (board[r][c] == '.')
+            return false;
+        marks[side_of(board[r][c])] &= ~(1 << (3 * r + c));
+        board[r][c] = '.';
+        n_moves--;
+        return true;
+    }
+
     if (board[r][c] != '.')
         return false;
 
     board[r][c] = s;
+    marks[side_of(s)] |= 1 << (3 * r + c);
+    n_moves++;
     return true;
 }
 
 bool Anti_XO_Board::is_lose(Player<char>* player)
 {
-    char sym = player->get_symbol();
-
-    for (int r = 0; r < 3; r++)
-        if (board[r][0] == sym && board[r][1] == sym && board[r][2] == sym)
-            return true;
-
-    for (int c = 0; c < 3; c++)
-        if (board[0][c] == sym && board[1][c] == sym && board[2][c] == sym)
-            return true;
-
-    if (board[0][0] == sym && board[1][1] == sym && board[2][2] == sym)
-        return true;
-
-    if (board[0][2] == sym && board[1][1] == sym && board[2][0] == sym)
-        return true;
-
-    return false;
+    return has_line(get_marks(player->get_symbol()));
 }
 
 bool Anti_XO_Board::is_draw(Player<char>* player)
 {
-    if (is_lose(player)) 
+    if (is_lose(player))
         return false;
 
-    for (int r = 0; r < 3; r++)
-        for (int c = 0; c < 3; c++)
-            if (board[r][c] == '.')
-                return false;
-
-    return true;
+    return (marks[0] | marks[1]) == 0x1FF;
 }
 
 bool Anti_XO_Board::game_is_over(Player<char>* player)
@@ -63,7 +63,7 @@ bool Anti_XO_Board::game_is_over(Player<char>* player)
 }
 
 
-Anti_XO_UI::Anti_XO_UI() 
+Anti_XO_UI::Anti_XO_UI()
     : UI<char>("anti_XO",3) {}
 
 Player<char>* Anti_XO_UI::create_player(string& name, char symbol, PlayerType type)
@@ -74,16 +74,18 @@ Player<char>* Anti_XO_UI::create_player(string& name, char symbol, PlayerType ty
 Move<char>* Anti_XO_UI::get_move(Player<char>* player)
 {
     int r, c;
-    
+
     if (player->get_type() == PlayerType::HUMAN) {
         cout << player->get_name() << " (" << player->get_symbol()
              << ") enter your move (row col): ";
         cin >> r >> c;
     } else if (player->get_type() == PlayerType::COMPUTER) {
+        // Perfect play from the solved table
         Anti_XO_Board* b = dynamic_cast<Anti_XO_Board*>(player->get_board_ptr());
-        auto best = b->neighbors_are_lava(player->get_symbol());
-        r  = best.first;
-        c =  best.second;
+        char s = player->get_symbol();
+        int cell = Anti_XO_Solver::best_move(b->get_marks(s), b->get_marks(s == 'X' ? 'O' : 'X'));
+        r = cell / 3;
+        c = cell % 3;
     }
 
     return new Move<char>(r, c, player->get_symbol());
@@ -122,13 +124,13 @@ std::pair<int, int> Anti_XO_Board::neighbors_are_lava(char s)
     sort(scores.begin(), scores.end(),
          [](auto &a, auto &b){ return a.first < b.first; });
 
- 
-    //to have random behaviar kinda  ya3ny :) .    
-    const int K = 2;  
+
+    //to have random behaviar kinda  ya3ny :) .
+    const int K = 2;
     int maxChoices = min(K, (int)scores.size());
 
-    
-    int idx = rand() % maxChoices;
+
+    int idx = Random::local().below(maxChoices);
 
     auto &choice = scores[idx];
     return { choice.second.first, choice.second.second };
@@ -138,5 +140,74 @@ std::pair<int, int> Anti_XO_Board::neighbors_are_lava(char s)
 
 bool Anti_XO_Board::bounded(int x, int y)
 {
-    return (x>0 && x<3 && y>0 && y<3);
+    return (x>=0 && x<3 && y>=0 && y<3);
+}
+
+//--------------------------------------- Anti_XO_Solver Implementation
+
+int8_t Anti_XO_Solver::values[Anti_XO_Solver::STATES];
+bool Anti_XO_Solver::built = false;
+
+uint32_t Anti_XO_Solver::key(uint16_t mine, uint16_t theirs)
+{
+    uint64_t first = mine, second = theirs;
+    Symmetry<3>::canonical_pair(first, second);
+    return uint32_t(first | second << 9);
+}
+
+void Anti_XO_Solver::build()
+{
+    if (built) return;
+    for (auto& v : values) v = UNSOLVED;
+    built = true;
+    solve(0, 0);
+}
+
+int Anti_XO_Solver::solve(uint16_t mine, uint16_t theirs)
+{
+    uint16_t empty = 0x1FF & ~(mine | theirs);
+    if (empty == 0) return 0;
+
+    uint32_t k = key(mine, theirs);
+    if (values[k] != UNSOLVED) return values[k];
+
+    // Completing a line loses at once; otherwise the opponent moves next
+    int left = __builtin_popcount(empty) - 1;
+    int best = -100;
+    for (uint16_t e = empty; e; e &= e - 1) {
+        uint16_t next = mine | (e & -e);
+        int v = Anti_XO_Board::has_line(next) ? -(1 + left) : -solve(theirs, next);
+        if (v > best) best = v;
+    }
+
+    values[k] = int8_t(best);
+    return best;
+}
+
+int Anti_XO_Solver::best_move(uint16_t mine, uint16_t theirs)
+{
+    build();
+    uint16_t empty = 0x1FF & ~(mine | theirs);
+    if (empty == 0) return -1;
+
+    int left = __builtin_popcount(empty) - 1;
+    int best = -100;
+    vector<int> cells;
+    for (int c = 0; c < 9; ++c) {
+        if (!(empty >> c & 1)) continue;
+        uint16_t next = mine | (1 << c);
+        int v = Anti_XO_Board::has_line(next) ? -(1 + left) : -solve(theirs, next);
+        if (v > best) {
+            best = v;
+            cells.clear();
+        }
+        if (v == best) cells.push_back(c);
+    }
+    return cells[Random::local().below(cells.size())];
+}
+
+int Anti_XO_Solver::value(uint16_t mine, uint16_t theirs)
+{
+    build();
+    return solve(mine, theirs);
 }
@@ -1,13 +1,21 @@
 #pragma once
  #include <utility>
  #include <vector>
+ #include <cstdint>
  #include <iostream>
  #include <algorithm>
  #include "../../header/BoardGame_Classes.h"
 
+/**
+ * @brief Anti XO (misère Tic-Tac-Toe): whoever completes three in a row loses.
+ *
+ * Next to the display matrix the board keeps a 9-bit bitboard per symbol
+ * (bit 3 * row + col), so checking a line is a few mask tests.
+ */
 class Anti_XO_Board : public Board<char>
 {
 private:
+    uint16_t marks[2] {};       ///< Cells of X ([0]) and O ([1]).
     bool bounded(int x,int y);
 public:
     Anti_XO_Board();
@@ -23,6 +31,60 @@ public:
     bool game_is_over(Player<char>* player) override;
 
     std::pair<int,int> neighbors_are_lava(char s);
+
+    /** @brief Cells of a symbol as a 9-bit mask. */
+    uint16_t get_marks(char s) const { return marks[side_of(s)]; }
+
+    /** @brief Bitboard index of a symbol: 0 for X, 1 for O. */
+    static int side_of(char s) { return (s == 'X' || s == 'x') ? 0 : 1; }
+
+    /** @brief True if a 9-bit cell mask holds three in a row. */
+    static bool has_line(uint16_t marks);
+};
+
+
+/**
+ * @brief Perfect play for Anti XO.
+ *
+ * Plain minimax over bitboards with the misère rule: a move completing a
+ * line loses on the spot, a full board without one is a draw. A position
+ * is the pair (mover's cells, opponent's cells), and only its canonical
+ * form over the 8 board symmetries (see Symmetry.h) is stored, so every
+ * reachable position is solved once, on first use, in a few thousand
+ * steps. Values favour the fastest win and the slowest loss.
+ */
+class Anti_XO_Solver {
+public:
+    static const int STATES = 1 << 18;      ///< Mover's cells | opponent's cells << 9.
+
+    /**
+     * @brief Best cell for the side to move (ties broken at random).
+     * @param mine The mover's cells.
+     * @param theirs The opponent's cells.
+     * @return The cell as 3 * row + col, or -1 on a full board.
+     */
+    static int best_move(uint16_t mine, uint16_t theirs);
+
+    /**
+     * @brief Value for the side to move: positive for a win, negative for a loss, 0 for a draw.
+     * The magnitude is 1 + the number of empty cells left when the game ends.
+     */
+    static int value(uint16_t mine, uint16_t theirs);
+
+private:
+    /** @brief Solve every position reachable from the empty board (once). */
+    static void build();
+
+    /** @brief Solve a position and the positions below it. */
+    static int solve(uint16_t mine, uint16_t theirs);
+
+    /** @brief Table index of the canonical form of a position. */
+    static uint32_t key(uint16_t mine, uint16_t theirs);
+
+    static const int8_t UNSOLVED = -128;    ///< Marks positions not solved yet.
+
+    static int8_t values[STATES];           ///< Value for the side to move, by canonical key.
+    static bool built;                      ///< build() has run.
 };
 
 
@@ -36,5 +98,3 @@ public:
 
     Move<char>* get_move(Player<char>* player) override;
 };
-
-
@@ -1,7 +1,14 @@
 // dia_XO.cpp
 #include "dia_XO.h"
+#include "../../header/Random.h"
 #include <algorithm>
 
+const int dia_XO_Board::STEP[4] = {9, 8, 1, 10};   // Vertical, anti-diagonal, horizontal, diagonal
+const uint64_t dia_XO_Board::VALID = 0x20E3EFEF8E08ULL;
+
+// Zobrist keys: one per side and cell
+static uint64_t zobrist[2][49];
+
 bool dia_XO_Board::bounded(int x, int y)
 {
     return (x >= 0 && x < 7 && y >= 0 && y < 7 && (board[x][y] == free));
@@ -26,6 +33,80 @@ dia_XO_Board::dia_XO_Board() : Board(7, 7)
             }
         }
     }
+
+    for (auto& o : owner) o = -1;
+
+    if (zobrist[0][0] == 0) {
+        Random rng(0xD1A3D1A3D1A3D1A3ULL);
+        for (auto& side : zobrist)
+            for (auto& key : side) key = rng.next();
+    }
+}
+
+void dia_XO_Board::play(int cell, int side)
+{
+    int p = padded(cell);
+    Step step;
+    step.cell = uint8_t(p);
+    step.side = uint8_t(side);
+
+    for (int d = 0; d < 4; ++d) {
+        int s = STEP[d];
+        int before = owner[p - s] == side ? run[side][d][p - s] : 0;
+        int after = owner[p + s] == side ? run[side][d][p + s] : 0;
+        step.before[d] = uint8_t(before);
+        step.after[d] = uint8_t(after);
+        step.longest[d] = longest[side][d];
+
+        // The joined run's length goes to its two ends
+        uint8_t len = uint8_t(before + after + 1);
+        run[side][d][p - before * s] = len;
+        run[side][d][p + after * s] = len;
+        if (len > longest[side][d]) longest[side][d] = len;
+    }
+
+    owner[p] = int8_t(side);
+    stones[side] |= uint64_t(1) << cell;
+    hash ^= zobrist[side][cell];
+    board[cell / 7][cell % 7] = side == 0 ? 'X' : 'O';
+    n_moves++;
+    history.push_back(step);
+}
+
+void dia_XO_Board::undo()
+{
+    Step step = history.back();
+    history.pop_back();
+
+    int p = step.cell, side = step.side;
+    int cell = 7 * (p / 9 - 1) + p % 9 - 1;
+
+    // The runs on either side end next to the cell again
+    for (int d = 0; d < 4; ++d) {
+        int s = STEP[d];
+        int before = step.before[d], after = step.after[d];
+        run[side][d][p] = 0;
+        if (before) run[side][d][p - s] = run[side][d][p - before * s] = uint8_t(before);
+        if (after) run[side][d][p + s] = run[side][d][p + after * s] = uint8_t(after);
+        longest[side][d] = step.longest[d];
+    }
+
+    owner[p] = -1;
+    stones[side] &= ~(uint64_t(1) << cell);
+    hash ^= zobrist[side][cell];
+    board[cell / 7][cell % 7] = free;
+    n_moves--;
+}
+
+bool dia_XO_Board::has_won(int side) const
+{
+    // A direction with four also has three, so a second direction with three is needed
+    int three = 0, four = 0;
+    for (int d = 0; d < 4; ++d) {
+        three += longest[side][d] >= 3;
+        four += longest[side][d] >= 4;
+    }
+    return four > 0 && three >= 2;
 }
 
 bool dia_XO_Board::update_board(Move<char> *move)
@@ -37,60 +118,21 @@ bool dia_XO_Board::update_board(Move<char> *move)
     if (x < 0 || x >= 7 || y < 0 || y >= 7) {
         return false;
     }
+    if (s == 0) { // Undo: only the last stone can be taken back
+        if (history.empty() || history.back().cell != padded(7 * x + y)) return false;
+        undo();
+        return true;
+    }
     if (board[x][y] != free) {
         return false;
     }
-    board[x][y] = s;
+    play(7 * x + y, side_of(s));
     return true;
 }
 
 bool dia_XO_Board::is_win(Player<char> *player)
 {
-    char s = player->get_symbol();
-
-
-    int best_len[4] = {0, 0, 0, 0};
-
-    for (int i = 0; i < 7; ++i) {
-        for (int j = 0; j < 7; ++j) {
-            if (board[i][j] != s) continue;
-            if (board[i][j] == invalid) continue;
-
-            for (int d = 0; d < 4; ++d) {
-                int ddx = dx[d];
-                int ddy = dy[d];
-
-                int sx = i, sy = j;
-                while (true) {
-                    int px = sx - ddx;
-                    int py = sy - ddy;
-                    if (px < 0 || px >= 7 || py < 0 || py >= 7) break;
-                    if (board[px][py] != s) break;
-                    sx = px; sy = py;
-                }
-
-                int len = 0;
-                int cx = sx, cy = sy;
-                while (cx >= 0 && cx < 7 && cy >= 0 && cy < 7 && board[cx][cy] == s) {
-                    ++len;
-                    cx += ddx;
-                    cy += ddy;
-                }
-
-                if (len > best_len[d]) best_len[d] = len;
-            }
-        }
-    }
-
-    for (int d3 = 0; d3 < 4; ++d3) {
-        if (best_len[d3] < 3) continue;
-        for (int d4 = 0; d4 < 4; ++d4) {
-            if (d3 == d4) continue;
-            if (best_len[d4] >= 4) return true;
-        }
-    }
-
-    return false;
+    return has_won(side_of(player->get_symbol()));
 }
 
 bool dia_XO_Board::is_lose(Player<char> *player)
@@ -100,12 +142,7 @@ bool dia_XO_Board::is_lose(Player<char> *player)
 
 bool dia_XO_Board::is_draw(Player<char> *player)
 {
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            if (board[i][j] == free) return false;
-        }
-    }
-    return true;
+    return empty_cells() == 0;
 }
 
 bool dia_XO_Board::game_is_over(Player<char> *player)
@@ -126,16 +163,167 @@ Player<char>* dia_XO_UI::create_player(string& name, char symbol, PlayerType typ
 Move<char>* dia_XO_UI::get_move(Player<char>* player)
 {
     int r, c;
-    
+
     if (player->get_type() == PlayerType::HUMAN) {
         cout << player->get_name() << " (" << player->get_symbol()
              << ") enter your move (row col): ";
         cin >> r >> c;
-    } 
+    }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        r = std::rand() % 7;
-        c = std::rand() % 7;
+        auto* b = static_cast<dia_XO_Board*>(player->get_board_ptr());
+        int cell = engine.best_move(b, dia_XO_Board::side_of(player->get_symbol()), timeLimitMs);
+        r = cell / 7;
+        c = cell % 7;
     }
 
     return new Move<char>(r, c, player->get_symbol());
 }
+//=====================AI===========
+
+// Segments of three and four diamond cells in a line, as 7x7 bitboards
+static vector<uint64_t> segments[2];
+
+// Cells of the diamond, centre first
+static int order[25];
+
+dia_XO_Engine::dia_XO_Engine(int tableBits)
+    : table(size_t(1) << tableBits), tableMask((uint64_t(1) << tableBits) - 1)
+{
+    if (!segments[0].empty()) return;
+
+    static const int DIRS[4][2] = {{1, 0}, {1, -1}, {0, 1}, {1, 1}};
+    auto on = [](int r, int c) { return r >= 0 && r < 7 && c >= 0 && c < 7 && (dia_XO_Board::VALID >> (7 * r + c) & 1); };
+    for (int len = 3; len <= 4; ++len)
+        for (int cell = 0; cell < 49; ++cell)
+            for (auto& d : DIRS) {
+                uint64_t mask = 0;
+                int k = 0;
+                for (; k < len && on(cell / 7 + k * d[0], cell % 7 + k * d[1]); ++k)
+                    mask |= uint64_t(1) << (7 * (cell / 7 + k * d[0]) + cell % 7 + k * d[1]);
+                if (k == len) segments[len - 3].push_back(mask);
+            }
+
+    int n = 0;
+    for (int cell = 0; cell < 49; ++cell)
+        if (dia_XO_Board::VALID >> cell & 1) order[n++] = cell;
+    auto distance = [](int cell) { return abs(cell / 7 - 3) + abs(cell % 7 - 3); };
+    stable_sort(order, order + 25, [&](int a, int b) { return distance(a) < distance(b); });
+}
+
+int dia_XO_Engine::best_move(dia_XO_Board* board, int side, int timeLimitMs)
+{
+    this->board = board;
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(timeLimitMs);
+    nodes = 0;
+    stopped = false;
+
+    uint64_t empty = board->empty_cells();
+    if (empty == 0) return -1;
+
+    int best = -1;
+    for (int cell : order) {
+        if (!(empty >> cell & 1)) continue;
+        if (best < 0) best = cell;
+
+        // A winning placement needs no search
+        board->play(cell, side);
+        bool won = board->has_won(side);
+        board->undo();
+        if (won) return cell;
+    }
+
+    int empties = __builtin_popcountll(empty);
+    for (int depth = 1; depth <= empties; ++depth) {
+        int value = negamax(side, depth, -WIN, WIN);
+        if (stopped) break;   // An unfinished iteration is not trusted
+
+        const Entry& e = table[board->get_hash() & tableMask];
+        if (e.key == board->get_hash() && e.move >= 0 && (empty >> e.move & 1)) best = e.move;
+
+        if (empties == 1 || abs(value) > WIN / 2) break;
+    }
+    return best;
+}
+
+int dia_XO_Engine::negamax(int side, int depth, int alpha, int beta)
+{
+    // The previous move may have ended the game
+    if (board->has_won(1 - side))
+        return -(WIN - board->get_moves());
+
+    uint64_t empty = board->empty_cells();
+    if (empty == 0) return 0;
+
+    for (uint64_t e = empty; e; e &= e - 1) {
+        int cell = __builtin_ctzll(e);
+        board->play(cell, side);
+        bool won = board->has_won(side);
+        board->undo();
+        if (won) return WIN - (board->get_moves() + 1);
+    }
+
+    if (depth == 0) return evaluate(side);
+
+    if ((++nodes & 4095) == 0 && chrono::steady_clock::now() >= deadline) stopped = true;
+    if (stopped) return 0;
+
+    uint64_t key = board->get_hash();
+    Entry& slot = table[key & tableMask];
+    int ttMove = -1;
+
+    if (slot.key == key) {
+        ttMove = slot.move;
+        if (slot.depth >= depth) {
+            if (slot.bound == EXACT) return slot.value;
+            if (slot.bound == LOWER && slot.value >= beta) return slot.value;
+            if (slot.bound == UPPER && slot.value <= alpha) return slot.value;
+        }
+    }
+
+    // Order: table move, then centre first
+    int moves[25], count = 0;
+    if (ttMove >= 0 && (empty >> ttMove & 1)) moves[count++] = ttMove;
+    for (int cell : order)
+        if ((empty >> cell & 1) && cell != ttMove) moves[count++] = cell;
+
+    int origAlpha = alpha;
+    int best = -WIN, bestMove = moves[0];
+
+    for (int i = 0; i < count; ++i) {
+        board->play(moves[i], side);
+        int val = -negamax(1 - side, depth - 1, -beta, -alpha);
+        board->undo();
+        if (stopped) return 0;
+
+        if (val > best) {
+            best = val;
+            bestMove = moves[i];
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    slot.key = key;
+    slot.value = (int16_t)best;
+    slot.depth = (uint8_t)depth;
+    slot.move = (int8_t)bestMove;
+    slot.bound = best <= origAlpha ? UPPER : (best >= beta ? LOWER : EXACT);
+
+    return best;
+}
+
+int dia_XO_Engine::evaluate(int side) const
+{
+    // Segments open to one side only, by stones already in them
+    static const int WEIGHT[2][5] = {{0, 1, 4, 0, 0}, {0, 1, 3, 10, 0}};
+
+    int score = 0;
+    for (int s : {side, 1 - side}) {
+        uint64_t mine = board->get_stones(s), theirs = board->get_stones(1 - s);
+        int sign = (s == side) ? 1 : -1;
+        for (int len = 0; len < 2; ++len)
+            for (uint64_t seg : segments[len])
+                if (!(seg & theirs)) score += sign * WEIGHT[len][__builtin_popcountll(seg & mine)];
+    }
+    return score;
+}
@@ -1,22 +1,56 @@
 #pragma once
 
+ #include <chrono>
  #include <vector>
  #include <utility>
+ #include <cstdint>
  #include <unordered_set>
  #include "../../header/BoardGame_Classes.h"
 
 
 typedef std::unordered_set<std::vector<std::pair<int,int>>> zengy;
+
+/**
+ * @brief Diamond XO: the 25 cells with |row - 3| + |col - 3| <= 3 of a 7x7 grid.
+ *        A player wins with a line of three and a line of four in two different directions.
+ *
+ * Cells are kept on a 9x9 grid with a one-cell border of never-owned cells,
+ * so walking off the diamond needs no bounds checks. For every player and
+ * direction the length of each run is stored at both of its ends: placing a
+ * stone joins the runs ending next to it on either side and writes the new
+ * length at the two new ends, four directions at O(1) each. The longest run
+ * per direction only grows with placements, so the win condition is a check
+ * on four counters. Undo restores everything from the move's saved state.
+ */
 class dia_XO_Board: public Board<char>
 {
 
 private:
-    int dx[8] = { -1, -1,  0, 1, 1,  1,  0, -1 };
-    int dy[8] = {  0,  1,  1, 1, 0, -1, -1, -1 };
+    /**
+     * @brief What a placement changed, for undo.
+     */
+    struct Step {
+        uint8_t cell;           ///< Padded cell index.
+        uint8_t side;           ///< 0 for X, 1 for O.
+        uint8_t before[4];      ///< Run length ending just before the cell, per direction.
+        uint8_t after[4];       ///< Run length starting just after the cell, per direction.
+        uint8_t longest[4];     ///< The side's longest runs before the move.
+    };
+
     char  invalid = 'z';
     char  free = '.';
+    int8_t owner[81];                   ///< Side owning each padded cell, -1 if empty or off the diamond.
+    uint8_t run[2][4][81] {};           ///< Run length stored at both ends of each run.
+    uint8_t longest[2][4] {};           ///< Longest run per side and direction.
+    uint64_t stones[2] {};              ///< Stones of each side as 7x7 bitboards (bit 7 * row + col).
+    uint64_t hash = 0;                  ///< Zobrist hash of the stones.
+    std::vector<Step> history;          ///< Placements, for undo.
     bool bounded(int x,int y);
+
 public:
+    static const int STEP[4];           ///< Padded index step of each direction.
+    static const uint64_t VALID;        ///< The diamond's cells as a 7x7 bitboard.
+
     dia_XO_Board();
 
     bool update_board(Move<char>* move) override;
@@ -28,11 +62,107 @@ public:
     bool is_draw(Player<char>* player) override;
 
     bool game_is_over(Player<char>* player) override;
+
+    /**
+     * @brief Place a stone without any checks (the cell must be empty and on the diamond).
+     * @param cell Cell index 7 * row + col.
+     * @param side 0 for X, 1 for O.
+     */
+    void play(int cell, int side);
+
+    /** @brief Take back the last stone placed. */
+    void undo();
+
+    /** @brief True if a side has a line of three and a line of four in different directions. */
+    bool has_won(int side) const;
+
+    /** @brief Empty cells of the diamond as a 7x7 bitboard. */
+    uint64_t empty_cells() const { return VALID & ~(stones[0] | stones[1]); }
+
+    /** @brief Stones of a side as a 7x7 bitboard. */
+    uint64_t get_stones(int side) const { return stones[side]; }
+
+    /** @brief Zobrist hash of the stones. */
+    uint64_t get_hash() const { return hash; }
+
+    /** @brief Number of stones placed. */
+    int get_moves() const { return n_moves; }
+
+    /** @brief Side index of a symbol: 0 for X, 1 for O. */
+    static int side_of(char s) { return (s == 'X' || s == 'x') ? 0 : 1; }
+
+    /** @brief Padded index of cell 7 * row + col. */
+    static int padded(int cell) { return (cell / 7 + 1) * 9 + cell % 7 + 1; }
+};
+
+
+/**
+ * @brief Alpha-beta search engine for Diamond XO.
+ *
+ * Negamax with a transposition table keyed by the board's Zobrist hash and
+ * iterative deepening under a time budget. Winning placements are found
+ * before anything is searched, and leaves are scored by the segments of
+ * three and four cells still open to one side only.
+ */
+class dia_XO_Engine {
+public:
+    /**
+     * @brief Construct the engine and allocate its transposition table.
+     * @param tableBits log2 of the number of transposition table entries.
+     */
+    explicit dia_XO_Engine(int tableBits = 20);
+
+    /**
+     * @brief Search the board until the time budget runs out (the board is restored).
+     * @param board The live game board.
+     * @param side The side to move: 0 for X, 1 for O.
+     * @param timeLimitMs Time budget in milliseconds.
+     * @return The best cell as 7 * row + col, -1 if the board is full.
+     */
+    int best_move(dia_XO_Board* board, int side, int timeLimitMs);
+
+private:
+    /**
+     * @brief A transposition table slot.
+     */
+    struct Entry {
+        uint64_t key = 0;       ///< Zobrist hash, 0 when empty.
+        int16_t value = 0;      ///< Stored score.
+        uint8_t depth = 0;      ///< Depth the score was searched to.
+        uint8_t bound = 0;      ///< EXACT, LOWER or UPPER.
+        int8_t move = -1;       ///< Best cell found in this position.
+    };
+
+    enum : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @brief Negamax alpha-beta search.
+     * @return Score for the side to move; WIN - moves for a won game.
+     */
+    int negamax(int side, int depth, int alpha, int beta);
+
+    /**
+     * @brief Static evaluation from the open segments of each side.
+     * @return Score for the side to move.
+     */
+    int evaluate(int side) const;
+
+    static const int WIN = 10000;               ///< Base score of a win (minus the moves played).
+
+    dia_XO_Board* board = nullptr;              ///< Board being searched.
+    std::vector<Entry> table;                   ///< Transposition table (power of two size).
+    uint64_t tableMask;                         ///< Index mask for the table.
+    std::chrono::steady_clock::time_point deadline;   ///< Time at which the search stops.
+    long long nodes = 0;                        ///< Nodes visited in the current search.
+    bool stopped = false;                       ///< True once the time budget ran out.
 };
 
 
 class dia_XO_UI : public UI<char>
 {
+private:
+    dia_XO_Engine engine;       ///< Search engine used by the computer player.
+    int timeLimitMs = 1000;     ///< Thinking time per computer move.
 public:
     dia_XO_UI();
     ~dia_XO_UI() {}
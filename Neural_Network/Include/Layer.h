@@ -50,11 +50,13 @@ public:
      * @param neurons    Number of neurons
      * @param act        Activation function
      * @param actDeriv   Activation derivative function
+     * @param rng        Generator for the initial weights and biases
      */
     Layer(int inputSize,
           int neurons,
           std::function<double(double)> act,
-          std::function<double(double)> actDeriv);
+          std::function<double(double)> actDeriv,
+          Random& rng = Random::local());
 
     /**
      * @brief Forward propagation.
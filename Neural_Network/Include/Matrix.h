@@ -5,6 +5,7 @@
 #include <functional>
 #include <iostream>
 #include <stdexcept>
+#include "../../header/Random.h"
 
 /**
  * @class Matrix
@@ -62,8 +63,9 @@ public:
      * @param cols Number of columns
      * @param min Lower bound
      * @param max Upper bound
+     * @param rng Generator to draw from (the calling thread's by default)
      */
-    static Matrix random(int rows, int cols, T min, T max);
+    static Matrix random(int rows, int cols, T min, T max, Random& rng = Random::local());
 
     // ---------------------------------------------------------------------
     // Element Access
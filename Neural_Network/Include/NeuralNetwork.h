@@ -32,10 +32,12 @@ public:
      * @param layerSizes Vector specifying the number of neurons in each layer (including input and output).
      * @param activations Vector of activation functions for each layer (excluding input layer).
      * @param activationDerivatives Vector of derivatives of the activation functions for backpropagation.
+     * @param rng Generator for the initial weights (the calling thread's by default).
      */
     NeuralNetwork(const std::vector<int>& layerSizes,
                   const std::vector<std::function<double(double)>>& activations,
-                  const std::vector<std::function<double(double)>>& activationDerivatives);
+                  const std::vector<std::function<double(double)>>& activationDerivatives,
+                  Random& rng = Random::local());
 
     /**
      * @brief Perform a forward pass through all layers.
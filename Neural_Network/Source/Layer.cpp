@@ -5,11 +5,12 @@
 Layer::Layer(int inputSize,
              int neuronCount,
              std::function<double(double)> act,
-             std::function<double(double)> actDeriv)
+             std::function<double(double)> actDeriv,
+             Random& rng)
     : inputSize_(inputSize),
       neuronCount_(neuronCount),
-      W_(Matrix<double>::random(neuronCount_, inputSize_, -1.0, 1.0)),
-      B_(Matrix<double>::random(neuronCount_, 1, -1.0, 1.0)),
+      W_(Matrix<double>::random(neuronCount_, inputSize_, -1.0, 1.0, rng)),
+      B_(Matrix<double>::random(neuronCount_, 1, -1.0, 1.0, rng)),
       Z_(neuronCount_, 1),
       A_(neuronCount_, 1),
       lastInput_(inputSize_, 1),
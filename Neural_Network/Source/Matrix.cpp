@@ -1,5 +1,4 @@
 #include "../Include/Matrix.h"
-#include <random>
 #include <cmath>
 #include <iomanip>
 
@@ -27,14 +26,11 @@ Matrix<T>::Matrix(const std::vector<T>& values, int rows_, int cols_)
  *-------------------------------------------------------------*/
 
 template <class T>
-Matrix<T> Matrix<T>::random(int rows, int cols, T min, T max) {
+Matrix<T> Matrix<T>::random(int rows, int cols, T min, T max, Random& rng) {
     Matrix<T> m(rows, cols);
 
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_real_distribution<T> dist(min, max);
-
     for (auto &v : m.data) 
-        v = dist(rng);
+        v = static_cast<T>(rng.uniform(min, max));
 
     return std::move(m);
 }
@@ -6,14 +6,15 @@
 NeuralNetwork::NeuralNetwork(
     const std::vector<int>& layerSizes,
     const std::vector<std::function<double(double)>>& activations,
-    const std::vector<std::function<double(double)>>& activationDerivatives)
+    const std::vector<std::function<double(double)>>& activationDerivatives,
+    Random& rng)
 {
     if (layerSizes.size() < 2 || activations.size() != layerSizes.size() - 1 || activationDerivatives.size() != layerSizes.size() - 1)
         throw std::runtime_error("NeuralNetwork constructor: size mismatch");
 
     layers_.clear();
     for (size_t i = 1; i < layerSizes.size(); ++i) {
-        layers_.emplace_back(layerSizes[i-1], layerSizes[i], activations[i-1], activationDerivatives[i-1]);
+        layers_.emplace_back(layerSizes[i-1], layerSizes[i], activations[i-1], activationDerivatives[i-1], rng);
     }
 }
 
@@ -9,6 +9,7 @@ for refrence for now
 #include <iomanip>
 #include <cctype> // for toupper()
 #include "../header/XO_Classes.h"
+#include "../header/Random.h"
 
 using namespace std;
 
@@ -112,6 +113,11 @@ bool X_O_Board::game_is_over(Player<char> *player)
     return is_win(player) || is_draw(player) || is_lose(player);
 }
 
+Board<char>* X_O_Board::clone() const
+{
+    return new X_O_Board(*this);
+}
+
 //--------------------------------------- XO_UI Implementation
 
 XO_UI::XO_UI() : Custom_UI<char>("Weclome to FCAI X-O Game by Dr El-Ramly", 3) {}
@@ -126,11 +132,34 @@ Move<char> *XO_UI::get_move(Player<char> *player)
         << ") enter your move (row col): ";
         cin >> r >> c;
     } else if (player->get_type() == PlayerType::COMPUTER) {
-        r = std::rand()%5, c = std::rand()%5;
+        r = Random::local().below(3), c = Random::local().below(3);
     } else if (player->get_type() == PlayerType::AI) {
-        std::pair move = bestMove(player, 9);
-        r = move.first, c = move.second;
+        // Every reachable position is solved; search only if the table lacks this one
+        Tablebase<char>::Record solved;
+        bool known = tablebase().probe(player->get_board_ptr(), player->get_symbol(), solved);
+        if (known && solved.x >= 0) {
+            r = solved.x, c = solved.y;
+        } else {
+            std::pair move = bestMove(player, 9);
+            r = move.first, c = move.second;
+        }
     }
     
     return new Move<char>(r, c, player->get_symbol());
 }
+
+const Tablebase<char>& XO_UI::tablebase()
+{
+    static Tablebase<char> table = [] {
+        Tablebase<char> t('X', 'O', [](Board<char>* board, char symbol, vector<Move<char>>& moves) {
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 3; ++c)
+                    if (board->get_cell(r, c) == '.') moves.emplace_back(r, c, symbol);
+        }, Tablebase<char>::square_base3<3>('.', 'X', 'O'),
+           Tablebase<char>::square_cells<3>());
+        X_O_Board start;
+        t.build(&start, 'X');
+        return t;
+    }();
+    return table;
+}
@@ -12,6 +12,7 @@
 #include <memory>      // Required for unique_ptr
 #include <limits>      // Required for input clearing
 #include <stdexcept>   // Required for exceptions
+#include <cstdlib>     // Required for getenv
 
 #include "Games/XO_inf/XO_inf.h"
 #include "Games/diamond_XO/dia_XO.h" 
@@ -23,6 +24,7 @@
 #include "Games/Large_Tic_Tac_Toe/Large_Tic_Tac_Toe.h" ///> Required for the game Board and UI
 #include "Games/PyramidXO/PyramidXO.h" ///> Required for the game Board and UI
 #include "header/BoardGame_Classes.h"
+#include "header/Random.h"
 #include "header/XO_Classes.h"
 #include "Games/Word_Tic_Tac_Toe/Word_Tic_Tac_Toe.h"
 #include "Games/Obstacles_Tic_Tac_Toe/Obstacles_Tic_Tac_Toe.h"
@@ -62,7 +64,9 @@ using namespace std;
 */
 int main() {
 
-    srand(static_cast<unsigned int>(time(0)));  // Seed the random number generator
+    // Seed the random number generators; GAME_SEED replays a run exactly
+    const char* seed = std::getenv("GAME_SEED");
+    Random::set_seed(seed && *seed ? std::strtoull(seed, nullptr, 10) : static_cast<uint64_t>(time(0)));
 
     // Temporary menu to test and run different games Aalaa, ALi Wael
     bool finish = false;
@@ -174,8 +178,12 @@ int main() {
 
             // ================= START GAME =================
             cout << "\n--- Starting the game ---\n";
-            GameManager<char> game(game_board, players, game_ui);
-            game.run();
+            {
+                // The manager unsubscribes the UI from the board on destruction,
+                // so it must go before the board is deleted below
+                GameManager<char> game(game_board, players, game_ui);
+                game.run();
+            }
             cout << "\n--- Game finished ---\n";
 
            
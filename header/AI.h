@@ -115,6 +115,9 @@ public:
         auto* board = player->get_board_ptr();
         char ai = player->get_symbol();
 
+        // Speculative moves are undone right away; keep them from the board's listeners
+        BoardEventMute<char> mute(board);
+
         int bestScore = -INF;
         std::pair<int,int> move{-1, -1};
 
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file Arena.h
+ * @brief Chunked bump allocator for search tree nodes.
+ */
+
+/**
+ * @class Arena
+ * @brief Hands out nodes from large fixed-size chunks and frees them all at once.
+ *
+ * Nodes are addressed by a 32-bit index (chunk << ChunkBits | offset) instead of
+ * a pointer, which halves the size of tree links and stays valid while the arena
+ * grows: chunks are never moved, and the chunk table is sized up front so that
+ * looking a node up never races with another thread adding a chunk.
+ *
+ * Supports:
+ *  - Per-thread chunks: each thread allocates through its own Cursor, which takes
+ *    a whole chunk from the shared pool and then bumps through it without locking
+ *  - Contiguous blocks, so all children of a node sit next to each other and can
+ *    be linked with a first index and a count
+ *  - O(1) reset: chunk memory is kept for the next search, only counters are cleared
+ *
+ * Nodes are not destroyed on reset; an allocated node is assigned N() instead.
+ *
+ * @tparam N Node type (default constructible and assignable).
+ * @tparam ChunkBits log2 of the number of nodes per chunk.
+ */
+template <typename N, unsigned ChunkBits = 14>
+class Arena {
+public:
+    using Index = uint32_t;
+    static const Index NONE = UINT32_MAX;             ///< Null link.
+    static const uint32_t CHUNK_SIZE = 1u << ChunkBits;
+
+    /**
+     * @brief A thread's current bump range; must not be shared between threads.
+     */
+    class Cursor {
+        friend class Arena;
+        Index next = 0;             ///< Next free index of the current chunk.
+        Index end = 0;              ///< One past the last index of the current chunk.
+        uint32_t generation = 0;    ///< Arena generation the range belongs to.
+    };
+
+    /**
+     * @brief Construct an empty arena.
+     * @param maxChunks Upper bound on the number of chunks (memory is only taken when used).
+     */
+    explicit Arena(uint32_t maxChunks = 4096)
+        : chunks(maxChunks) {
+        if (maxChunks == 0 || (uint64_t(maxChunks) << ChunkBits) > NONE)
+            throw std::invalid_argument("Error: Arena chunk count out of range.");
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Allocate a contiguous block of value-initialised nodes.
+     * @param cursor The calling thread's cursor.
+     * @param count Number of nodes (1 .. CHUNK_SIZE).
+     * @return Index of the first node; the rest follow at index + 1, index + 2, ...
+     * @throws std::length_error if the arena is out of chunks.
+     */
+    Index allocate(Cursor& cursor, uint32_t count = 1) {
+        Index first = try_allocate(cursor, count);
+        if (first == NONE) throw std::length_error("Error: Arena is full.");
+        return first;
+    }
+
+    /**
+     * @brief Allocate like allocate(), but report a full arena instead of throwing.
+     * Meant for worker threads, where an escaping exception would end the program.
+     * @return Index of the first node, or NONE if the arena is out of chunks.
+     */
+    Index try_allocate(Cursor& cursor, uint32_t count = 1) {
+        if (count == 0 || count > CHUNK_SIZE)
+            throw std::invalid_argument("Error: Arena block size out of range.");
+
+        // A stale cursor (from before reset) or a chunk without room: take a fresh chunk
+        if (cursor.generation != generation.load(std::memory_order_relaxed) ||
+            cursor.end - cursor.next < count)
+            if (!take_chunk(cursor)) return NONE;
+
+        Index first = cursor.next;
+        cursor.next += count;
+        N* block = &(*this)[first];
+        for (uint32_t i = 0; i < count; ++i) block[i] = N();
+        return first;
+    }
+
+    /** @brief Access a node by index. */
+    N& operator[](Index i) { return chunks[i >> ChunkBits][i & (CHUNK_SIZE - 1)]; }
+
+    /** @brief Access a node by index. */
+    const N& operator[](Index i) const { return chunks[i >> ChunkBits][i & (CHUNK_SIZE - 1)]; }
+
+    /**
+     * @brief Free every node in O(1); chunk memory is kept for reuse.
+     * Must not run while another thread is allocating. Outstanding cursors become
+     * stale and take a new chunk on their next allocation.
+     */
+    void reset() {
+        usedChunks.store(0, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** @brief Number of chunks handed out since the last reset. */
+    uint32_t chunks_in_use() const { return usedChunks.load(std::memory_order_relaxed); }
+
+    /** @brief Bytes of node memory held (used or kept for reuse). */
+    size_t memory_held() const { return size_t(allocatedChunks.load(std::memory_order_relaxed)) * CHUNK_SIZE * sizeof(N); }
+
+private:
+    /**
+     * @brief Point the cursor at a chunk nobody else is using.
+     * @return false if every chunk is taken (the cursor is then left unchanged).
+     */
+    bool take_chunk(Cursor& cursor) {
+        // Claim slot k only while one is left, so the count never runs past the table
+        uint32_t k = usedChunks.load(std::memory_order_relaxed);
+        do {
+            if (k >= chunks.size()) return false;
+        } while (!usedChunks.compare_exchange_weak(k, k + 1, std::memory_order_relaxed));
+
+        // Slot k belongs to this thread alone; it only needs memory the first time round
+        if (!chunks[k]) {
+            chunks[k].reset(new N[CHUNK_SIZE]);
+            allocatedChunks.fetch_add(1, std::memory_order_relaxed);
+        }
+        cursor.next = Index(k) << ChunkBits;
+        cursor.end = cursor.next + CHUNK_SIZE;
+        cursor.generation = generation.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    std::vector<std::unique_ptr<N[]>> chunks;  ///< Chunk table, fixed size so lookups never see it move.
+    std::atomic<uint32_t> usedChunks{0};       ///< Chunks handed out since the last reset.
+    std::atomic<uint32_t> generation{0};       ///< Bumped by reset to invalidate cursors.
+    std::atomic<uint32_t> allocatedChunks{0};  ///< Chunks with memory behind them.
+};
@@ -11,6 +11,7 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 using namespace std;
 
 /////////////////////////////////////////////////////////////
@@ -34,6 +35,33 @@ enum class PlayerType {
     RANDOM     ///< A Random player.
 };
 
+/**
+ * @brief Receives events from a board (typically the UI).
+ *
+ * @tparam T Type of the elements stored on the board.
+ *
+ * Boards stay free of console output and report what happened through these
+ * hooks instead; listeners cache what they need and show it when they draw.
+ * Every hook has an empty default, so a listener only overrides what it uses.
+ */
+template <typename T>
+class BoardListener {
+public:
+    virtual ~BoardListener() {}
+
+    /** @brief A move was applied to the board (symbol 0 for an undo). */
+    virtual void on_move_applied(const Move<T>& /*move*/) {}
+
+    /** @brief The score of the player with the given symbol changed. */
+    virtual void on_score_changed(T /*symbol*/, int /*score*/) {}
+
+    /**
+     * @brief A sub-board changed state.
+     * @param winner The winning symbol, a draw marker, or the blank symbol when an undo reopens it.
+     */
+    virtual void on_sub_board_won(int /*sub_row*/, int /*sub_col*/, T /*winner*/) {}
+};
+
 /**
  * @brief Base template for any board used in board games.
  *
@@ -50,6 +78,22 @@ protected:
     vector<vector<T>> board; ///< 2D vector for the board
     int n_moves = 0; ///< Number of moves made
 
+    /** @brief Tell every listener that a player's score changed. */
+    void notify_score_changed(T symbol, int score) {
+        if (events_muted) return;
+        for (auto* l : listeners) l->on_score_changed(symbol, score);
+    }
+
+    /** @brief Tell every listener that a sub-board changed state. */
+    void notify_sub_board_won(int sub_row, int sub_col, T winner) {
+        if (events_muted) return;
+        for (auto* l : listeners) l->on_sub_board_won(sub_row, sub_col, winner);
+    }
+
+private:
+    vector<BoardListener<T>*> listeners; ///< Subscribers to board events
+    bool events_muted = false;           ///< True while a search plays speculative moves
+
 public:
     /**
      * @brief Construct a board with given dimensions.
@@ -57,11 +101,34 @@ public:
     Board(int rows, int columns)
         : rows(rows), columns(columns), board(rows, vector<T>(columns)) {}
 
+    /**
+     * @brief Copy the board state. Listeners are not copied: a copy is a private scratch board.
+     */
+    Board(const Board& other)
+        : rows(other.rows), columns(other.columns), board(other.board), n_moves(other.n_moves) {}
+
+    /**
+     * @brief Assign the board state, keeping this board's own listeners.
+     */
+    Board& operator=(const Board& other) {
+        rows = other.rows;
+        columns = other.columns;
+        board = other.board;
+        n_moves = other.n_moves;
+        return *this;
+    }
+
     /**
      * @brief Virtual destructor. Frees allocated board memory.
      */
     virtual ~Board() {}
 
+    /**
+     * @brief Return a heap-allocated copy of the board, or nullptr if the game does not support it.
+     * Searches that work through the Board interface (e.g. MCTS) play on such copies.
+     */
+    virtual Board<T>* clone() const { return nullptr; }
+
     /**
      * @brief Update the board with a new move.
      * @param move The move object containing position and symbol.
@@ -99,6 +166,51 @@ public:
     T get_cell(int x, int y) {
         return board[x][y];
     }
+
+    /** @brief Subscribe a listener to the board's events. */
+    void add_listener(BoardListener<T>* listener) { listeners.push_back(listener); }
+
+    /** @brief Unsubscribe a listener. */
+    void remove_listener(BoardListener<T>* listener) {
+        listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+    }
+
+    /**
+     * @brief Mute or unmute events (searches mute them while playing speculative moves).
+     * @return The previous state.
+     */
+    bool mute_events(bool muted) {
+        bool was = events_muted;
+        events_muted = muted;
+        return was;
+    }
+
+    /** @brief Tell every listener that a move was applied. */
+    void notify_move_applied(const Move<T>& move) {
+        if (events_muted) return;
+        for (auto* l : listeners) l->on_move_applied(move);
+    }
+};
+
+/**
+ * @brief Mutes a board's events for the lifetime of the guard.
+ *
+ * @tparam T Type of the elements stored on the board.
+ *
+ * Searches that call update_board speculatively hold one of these so the UI
+ * does not see moves that are immediately undone.
+ */
+template <typename T>
+class BoardEventMute {
+    Board<T>* board;  ///< The muted board
+    bool was_muted;   ///< State to restore
+
+public:
+    explicit BoardEventMute(Board<T>* b) : board(b), was_muted(b->mute_events(true)) {}
+    ~BoardEventMute() { board->mute_events(was_muted); }
+
+    BoardEventMute(const BoardEventMute&) = delete;
+    BoardEventMute& operator=(const BoardEventMute&) = delete;
 };
 
 //-----------------------------------------------------
@@ -173,7 +285,7 @@ public:
  * @tparam T The type of symbol used on the board.
  */
 template <typename T>
-class UI {
+class UI : public BoardListener<T> {
 protected:
     int cell_width; ///< Width of each displayed board cell
 
@@ -280,6 +392,14 @@ public:
         players[1] = p[1];
         players[0]->set_board_ptr(b);
         players[1]->set_board_ptr(b);
+        boardPtr->add_listener(ui);
+    }
+
+    /**
+     * @brief Unsubscribe the UI from the board.
+     */
+    ~GameManager() {
+        boardPtr->remove_listener(ui);
     }
 
     /**
@@ -296,6 +416,7 @@ public:
 
                 while (!boardPtr->update_board(move))
                     move = ui->get_move(currentPlayer);
+                boardPtr->notify_move_applied(*move);
 
                 ui->display_board_matrix(boardPtr->get_board_matrix());
 
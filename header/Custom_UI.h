@@ -2,6 +2,7 @@
 #define CUSTOM_UI_H
 
 #include "BoardGame_Classes.h"
+#include "Random.h"
 #include <iostream>
 #include <vector>
 #include <stdexcept>
@@ -84,7 +85,7 @@ public:
 
         // Random type selection
         if (type == PlayerType::RANDOM) {
-            int i = std::rand() % 3;
+            int i = Random::local().below(3);
             if (i == 0)      type = PlayerType::HUMAN;
             else if (i == 1) type = PlayerType::COMPUTER;
             else             type = PlayerType::AI;
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "BoardGame_Classes.h"
+#include "Arena.h"
+#include "Random.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @file MCTS.h
+ * @brief Generic Monte Carlo Tree Search over the Board<T> interface.
+ */
+
+/**
+ * @class MCTS
+ * @brief Open-loop UCT search usable with any board that implements clone().
+ *
+ * The tree stores moves only. Every playout clones the root board, replays
+ * the moves down the selected path with update_board, expands the leaf,
+ * plays the rest of the game with the rollout policy and backs the result up.
+ * Game results are read through is_win / is_lose / is_draw exactly like
+ * GameManager does, so no game-specific code is needed beyond a move generator.
+ *
+ * Supports:
+ *  - Time and/or playout budgets (anytime: stop whenever, take the most visited move)
+ *  - Tree-parallel search: threads share one tree, with virtual loss steering
+ *    them apart; only tree walks and updates are locked, rollouts run in parallel
+ *  - A pluggable rollout policy (uniformly random by default)
+ *
+ * Nodes live in an Arena: each thread expands into its own chunk, the children
+ * of a node are one contiguous block, and dropping the tree between searches is O(1).
+ *
+ * @tparam T Type of symbol used on the board.
+ */
+template <typename T>
+class MCTS {
+public:
+    /**
+     * @brief Lists the candidate moves of the side to move.
+     * Moves that update_board then rejects are skipped, so a generator may be generous.
+     */
+    using MoveGenerator = std::function<void(Board<T>* board, T symbol, vector<Move<T>>& moves)>;
+
+    /**
+     * @brief Picks the index of the move to play during a rollout.
+     */
+    using RolloutPolicy = std::function<size_t(Board<T>* board, const vector<Move<T>>& moves, Random& rng)>;
+
+    /**
+     * @brief Search limits and tuning.
+     */
+    struct Options {
+        int timeLimitMs = 1000;         ///< Stop after this many milliseconds (0 = no limit).
+        long long maxPlayouts = 0;      ///< Stop after this many playouts (0 = no limit).
+        int threads = 1;                ///< Threads sharing the tree.
+        double exploration = 1.41421356; ///< UCT exploration constant.
+        int virtualLoss = 1;            ///< Visits charged to a node while a thread is below it.
+        int maxRolloutLength = 1000;    ///< Rollouts longer than this count as a draw.
+    };
+
+    /**
+     * @brief Construct the engine for a two-player game.
+     * @param first Symbol of one player.
+     * @param second Symbol of the other player.
+     * @param generator Move generator for the game.
+     * @param options Search limits and tuning.
+     */
+    MCTS(T first, T second, MoveGenerator generator, Options options = Options())
+        : symbols{first, second}, generator(std::move(generator)), options(options),
+          players{Player<T>("", first, PlayerType::COMPUTER), Player<T>("", second, PlayerType::COMPUTER)} {
+        policy = [](Board<T>*, const vector<Move<T>>& moves, Random& rng) {
+            return size_t(rng.below(uint32_t(moves.size())));
+        };
+    }
+
+    /** @brief Replace the rollout policy. */
+    void set_rollout_policy(RolloutPolicy p) { policy = std::move(p); }
+
+    /** @brief Access the options (budgets, threads, constants). */
+    Options& get_options() { return options; }
+
+    /** @brief Number of playouts made by the last search. */
+    long long get_playouts() const { return playouts; }
+
+    /**
+     * @brief A generator that proposes every cell holding the blank value.
+     * @param blank The value of an empty cell.
+     */
+    static MoveGenerator empty_cells(T blank) {
+        return [blank](Board<T>* board, T symbol, vector<Move<T>>& moves) {
+            for (int r = 0; r < board->get_rows(); ++r)
+                for (int c = 0; c < board->get_columns(); ++c)
+                    if (board->get_cell(r, c) == blank) moves.emplace_back(r, c, symbol);
+        };
+    }
+
+    /**
+     * @brief Search the position and return the most visited move.
+     * @param board The current board (left unchanged; it must implement clone()).
+     * @param toMove The symbol of the side to move.
+     * @return The chosen move, or (-1, -1) if the side to move has no move.
+     */
+    Move<T> search(Board<T>* board, T toMove) {
+        std::unique_ptr<Board<T>> probe(board->clone());
+        if (!probe) throw std::runtime_error("Error: MCTS needs a board that implements clone().");
+
+        nodes.reset();
+        typename Arena<Node>::Cursor cursor;
+        root = nodes.allocate(cursor);
+        rootSymbol = other(toMove);        // The root is "entered" by the side that just moved
+        nodes[root].symbol = rootSymbol;
+        playouts = 0;
+        arenaFull = false;
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.timeLimitMs);
+
+        // Every thread's rollouts draw from a generator seeded by the caller's
+        Random& seeder = Random::local();
+        vector<std::thread> pool;
+        for (int t = 1; t < options.threads; ++t)
+            pool.emplace_back([this, board, seed = seeder.next()] {
+                typename Arena<Node>::Cursor own;    // Each thread expands into chunks of its own
+                worker(board, seed, own);
+            });
+        worker(board, seeder.next(), cursor);
+        for (auto& th : pool) th.join();
+
+        // Robust child: the move with the most visits
+        uint32_t best = NONE;
+        const Node& r = nodes[root];
+        for (uint32_t c = r.firstChild; c < r.firstChild + r.childCount; ++c)
+            if (best == NONE || nodes[c].visits > nodes[best].visits) best = c;
+
+        if (best == NONE) return Move<T>(-1, -1, toMove);
+        return Move<T>(nodes[best].x, nodes[best].y, nodes[best].symbol);
+    }
+
+private:
+    static const uint32_t NONE = UINT32_MAX;
+
+    /**
+     * @brief A tree node; its children are the arena block [firstChild, firstChild + childCount).
+     */
+    struct Node {
+        uint32_t firstChild = NONE;     ///< First child, NONE until expanded.
+        uint32_t childCount = 0;        ///< Number of children.
+        int x = -1, y = -1;             ///< Move leading to this node.
+        T symbol{};                     ///< Player who made that move.
+        bool expanded = false;          ///< Children have been generated.
+        int visits = 0;                 ///< Completed playouts through this node.
+        int virtualLoss = 0;            ///< Playouts currently running below this node.
+        double wins = 0;                ///< Sum of results for symbol (1 win, 0.5 draw).
+    };
+
+    /** @brief The opponent of a symbol. */
+    T other(T s) const { return s == symbols[0] ? symbols[1] : symbols[0]; }
+
+    /**
+     * @brief Result of the move just made by mover: 1 if mover won, 0 if lost,
+     *        0.5 for a draw, -1 if the game goes on.
+     */
+    double outcome(Board<T>* b, T mover) {
+        Player<T>* p = &players[mover == symbols[0] ? 0 : 1];
+        if (b->is_win(p)) return 1.0;
+        if (b->is_lose(p)) return 0.0;
+        if (b->is_draw(p)) return 0.5;
+        return -1.0;
+    }
+
+    /** @brief True while the time and playout budgets allow another playout. */
+    bool has_budget() {
+        if (arenaFull) return false;
+        if (options.maxPlayouts > 0 && playouts >= options.maxPlayouts) return false;
+        if (options.timeLimitMs > 0 && std::chrono::steady_clock::now() >= deadline) return false;
+        return true;
+    }
+
+    /** @brief UCT child selection; charges virtual loss to the chosen child. */
+    uint32_t select_child(uint32_t n) {
+        const Node& parent = nodes[n];
+        double logN = std::log(double(parent.visits + parent.virtualLoss) + 1.0);
+        uint32_t best = NONE;
+        double bestValue = -1.0;
+
+        for (uint32_t c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+            const Node& child = nodes[c];
+            int n_c = child.visits + child.virtualLoss;
+            // Unvisited children first; virtual losses count as visits that scored 0
+            double value = n_c == 0 ? 1e9
+                         : child.wins / n_c + options.exploration * std::sqrt(logN / n_c);
+            if (value > bestValue) {
+                bestValue = value;
+                best = c;
+            }
+        }
+        nodes[best].virtualLoss += options.virtualLoss;
+        return best;
+    }
+
+    /**
+     * @brief Score a node whose move the board refused: a visit worth nothing to its mover.
+     * Keeps UCT from treating it as unvisited forever; its virtual loss is released.
+     */
+    void refuse(uint32_t n) {
+        nodes[n].virtualLoss -= options.virtualLoss;
+        nodes[n].visits += 1;
+    }
+
+    /** @brief Playout loop of one thread. */
+    void worker(Board<T>* board, uint64_t seed, typename Arena<Node>::Cursor& cursor) {
+        Random rng(seed);
+        vector<Move<T>> moves;
+        vector<Move<T>> pathMoves;
+        vector<uint32_t> path;
+
+        while (true) {
+            path.clear();
+            pathMoves.clear();
+            std::unique_ptr<Board<T>> b(board->clone());
+            double result = -1.0;      // Outcome for the mover of the last applied move
+            T mover = rootSymbol;
+
+            // 1. Selection: walk down the tree under the lock
+            {
+                std::lock_guard<std::mutex> lock(treeLock);
+                if (!has_budget()) return;
+                ++playouts;
+
+                uint32_t n = root;
+                nodes[n].virtualLoss += options.virtualLoss;
+                path.push_back(n);
+                while (nodes[n].expanded && nodes[n].childCount != 0) {
+                    n = select_child(n);
+                    path.push_back(n);
+                    pathMoves.emplace_back(nodes[n].x, nodes[n].y, nodes[n].symbol);
+                }
+            }
+
+            // 2. Replay the path on the clone (open loop: the tree holds moves, not states)
+            bool reached = true;
+            for (size_t i = 0; i < pathMoves.size(); ++i) {
+                // Stochastic games may refuse a stored move; roll out from where we got to,
+                // and leave the nodes past it out of the backup
+                if (!b->update_board(&pathMoves[i])) {
+                    reached = false;
+                    std::lock_guard<std::mutex> lock(treeLock);
+                    refuse(path[i + 1]);
+                    for (size_t j = i + 2; j < path.size(); ++j)
+                        nodes[path[j]].virtualLoss -= options.virtualLoss;
+                    path.resize(i + 1);
+                    break;
+                }
+                mover = pathMoves[i].get_symbol();
+                result = outcome(b.get(), mover);
+                if (result >= 0) break;
+            }
+
+            // 3. Expansion: add every move of the leaf, then step into the first unvisited one
+            if (result < 0 && reached) {
+                moves.clear();
+                generator(b.get(), other(mover), moves);
+
+                std::lock_guard<std::mutex> lock(treeLock);
+                uint32_t leaf = path.back();
+                if (!nodes[leaf].expanded) {
+                    // A full arena ends the search: no thread can grow the tree any more
+                    uint32_t first = moves.empty() ? NONE : nodes.try_allocate(cursor, uint32_t(moves.size()));
+                    if (first == NONE && !moves.empty()) {
+                        arenaFull = true;
+                    }
+                    else {
+                        nodes[leaf].expanded = true;
+                        for (size_t i = 0; i < moves.size(); ++i) {
+                            Node& child = nodes[first + uint32_t(i)];
+                            child.x = moves[i].get_x();
+                            child.y = moves[i].get_y();
+                            child.symbol = moves[i].get_symbol();
+                        }
+                        nodes[leaf].firstChild = first;
+                        nodes[leaf].childCount = uint32_t(moves.size());
+                    }
+                }
+                if (nodes[leaf].childCount != 0) {
+                    uint32_t child = select_child(leaf);
+                    Move<T> m(nodes[child].x, nodes[child].y, nodes[child].symbol);
+
+                    // Only a move the board accepts gets the rollout's result
+                    if (b->update_board(&m)) {
+                        path.push_back(child);
+                        mover = nodes[child].symbol;
+                        result = outcome(b.get(), mover);
+                    }
+                    else {
+                        refuse(child);
+                    }
+                }
+            }
+
+            // 4. Rollout: play the game out with the policy, outside the lock
+            for (int ply = 0; result < 0 && ply < options.maxRolloutLength; ++ply) {
+                moves.clear();
+                generator(b.get(), other(mover), moves);
+
+                bool played = false;
+                while (!moves.empty()) {
+                    size_t i = policy(b.get(), moves, rng);
+                    if (b->update_board(&moves[i])) { played = true; break; }
+                    moves[i] = moves.back();
+                    moves.pop_back();
+                }
+                if (!played) { result = 0.5; break; }   // No legal move: call it a draw
+
+                mover = other(mover);
+                result = outcome(b.get(), mover);
+            }
+            if (result < 0) result = 0.5;
+
+            // 5. Backpropagation: each node scores the result for the player who moved into it
+            std::lock_guard<std::mutex> lock(treeLock);
+            for (uint32_t n : path) {
+                Node& node = nodes[n];
+                node.visits += 1;
+                node.virtualLoss -= options.virtualLoss;
+                node.wins += (node.symbol == mover) ? result : 1.0 - result;
+            }
+        }
+    }
+
+    T symbols[2];                       ///< The two players' symbols.
+    MoveGenerator generator;            ///< Candidate moves of a position.
+    RolloutPolicy policy;               ///< Move choice during rollouts.
+    Options options;                    ///< Budgets and constants.
+    Player<T> players[2];               ///< Players used to query the board's result functions.
+
+    Arena<Node> nodes;                  ///< Node storage, kept across searches.
+    uint32_t root = NONE;               ///< Root node of the current search.
+    T rootSymbol{};                     ///< Player who moved into the root position.
+    std::mutex treeLock;                ///< Guards the tree and the playout counter.
+    long long playouts = 0;             ///< Playouts started in the current search.
+    bool arenaFull = false;             ///< The arena ran out of chunks during the current search.
+    std::chrono::steady_clock::time_point deadline;   ///< End of the time budget.
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file Random.h
+ * @brief Seedable per-thread random numbers (xoshiro256**).
+ */
+
+/**
+ * @class Random
+ * @brief Small, fast generator with a reproducible stream per thread.
+ *
+ * One process-wide seed drives everything: the first thread to use local()
+ * gets the seed's own stream, every later thread the next stream, 2^128
+ * draws further on (so threads never overlap or share state). Code that
+ * spreads work over its own threads should instead hand each thread a
+ * generator seeded from the caller's, which keeps the run reproducible
+ * whatever order the threads start in.
+ *
+ * Meets UniformRandomBitGenerator, so it also works with std::shuffle and
+ * friends; below() and uniform() are the portable, bit-reproducible choices.
+ */
+class Random {
+public:
+    using result_type = uint64_t;
+
+    /**
+     * @brief Construct a generator.
+     * @param seed Any value; expanded into the full state with splitmix64.
+     */
+    explicit Random(uint64_t seed = DEFAULT_SEED) { reseed(seed); }
+
+    /** @brief Restart the generator from a seed. */
+    void reseed(uint64_t seed) {
+        for (auto& word : s) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /** @brief Next 64 random bits. */
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    result_type operator()() { return next(); }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    /**
+     * @brief Uniform integer in [0, n), without modulo bias.
+     * @param n Upper bound (must be positive).
+     */
+    uint32_t below(uint32_t n) {
+        // Lemire's multiply-shift, rejecting the few products that would bias the result
+        uint64_t m = (next() >> 32) * n;
+        if (uint32_t(m) < n) {
+            uint32_t threshold = uint32_t(-n) % n;
+            while (uint32_t(m) < threshold) m = (next() >> 32) * n;
+        }
+        return uint32_t(m >> 32);
+    }
+
+    /** @brief Uniform double in [0, 1), from the top 53 bits. */
+    double uniform() { return double(next() >> 11) * 0x1.0p-53; }
+
+    /** @brief Uniform double in [lo, hi). */
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+
+    /** @brief Advance the generator by 2^128 draws (start of the next stream). */
+    void jump() {
+        static const uint64_t JUMP[4] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                         0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t word : JUMP)
+            for (int b = 0; b < 64; ++b) {
+                if (word & (uint64_t(1) << b))
+                    for (int i = 0; i < 4; ++i) t[i] ^= s[i];
+                next();
+            }
+        for (int i = 0; i < 4; ++i) s[i] = t[i];
+    }
+
+    /**
+     * @brief Set the process-wide seed and restart the calling thread's stream.
+     * Call it before other threads draw from local().
+     */
+    static void set_seed(uint64_t seed) {
+        state().seed.store(seed);
+        state().streams.store(0);
+        Random& mine = local();
+        mine.reseed(seed);
+        state().streams.store(1);
+    }
+
+    /** @brief The process-wide seed. */
+    static uint64_t get_seed() { return state().seed.load(); }
+
+    /** @brief The calling thread's generator. */
+    static Random& local() {
+        thread_local Random rng = stream(state().streams.fetch_add(1));
+        return rng;
+    }
+
+private:
+    static const uint64_t DEFAULT_SEED = 0x5EED5EED5EED5EEDULL;   ///< Seed used until set_seed().
+
+    /** @brief Process-wide seed and the number of streams handed out. */
+    struct Shared {
+        std::atomic<uint64_t> seed{DEFAULT_SEED};
+        std::atomic<uint32_t> streams{0};
+    };
+
+    static Shared& state() {
+        static Shared shared;
+        return shared;
+    }
+
+    /** @brief Stream k of the process-wide seed. */
+    static Random stream(uint32_t k) {
+        Random r(state().seed.load());
+        while (k-- > 0) r.jump();
+        return r;
+    }
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];                  ///< Generator state.
+};
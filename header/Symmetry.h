@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file Symmetry.h
+ * @brief The 8 symmetries of a square board, applied to bitboards with delta swaps.
+ */
+
+/**
+ * @class Symmetry
+ * @brief Rotations and reflections of an N x N board packed W bits per cell
+ *        (cell r, c is the W-bit field at bit W * (N * r + c)).
+ *
+ * Mirroring, flipping and transposing are each a handful of delta swaps (one
+ * shift-xor-mask exchange per pair of columns, rows or diagonals), so a whole
+ * board moves at once instead of cell by cell. The other symmetries are
+ * compositions of these three. With W = 1 this is a plain bitboard; wider
+ * fields move small per-cell codes (piece types, letter classes) the same way.
+ *
+ * Transforms are numbered as in the opening book: 0 identity, 1 rotate 90,
+ * 2 rotate 180, 3 rotate 270, 4 mirror (left-right), 5 flip (top-bottom),
+ * 6 transpose, 7 anti-transpose. Rotating 90 moves cell (r, c) to (c, N-1-r).
+ *
+ * Canonical forms are the smallest transformed value; for a pair of bitboards
+ * (X, O) the order is that of the key X | O << N*N, i.e. O first, then X.
+ *
+ * @tparam N Board side, 2 to 8.
+ * @tparam W Bits per cell (N * N * W must fit in 64 bits).
+ */
+template <int N, int W = 1>
+class Symmetry {
+    static_assert(N >= 2 && N <= 8, "Symmetry supports boards of 2x2 to 8x8");
+    static_assert(W >= 1 && N * N * W <= 64, "Symmetry needs the packed board to fit in 64 bits");
+
+public:
+    static constexpr int CELLS = N * N;     ///< Cells on the board.
+
+    /** @brief Exchange the bits in mask with the bits delta places above them. */
+    static constexpr uint64_t delta_swap(uint64_t b, uint64_t mask, int delta) {
+        uint64_t t = ((b >> delta) ^ b) & mask;
+        return b ^ t ^ (t << delta);
+    }
+
+    /** @brief Reflect left-right: (r, c) -> (r, N-1-c). */
+    static constexpr uint64_t mirror(uint64_t b) {
+        for (int j = 0; j < N / 2; ++j)
+            b = delta_swap(b, column_mask(j), (N - 1 - 2 * j) * W);
+        return b;
+    }
+
+    /** @brief Reflect top-bottom: (r, c) -> (N-1-r, c). */
+    static constexpr uint64_t flip(uint64_t b) {
+        for (int i = 0; i < N / 2; ++i)
+            b = delta_swap(b, row_mask(i), (N - 1 - 2 * i) * N * W);
+        return b;
+    }
+
+    /** @brief Reflect in the main diagonal: (r, c) -> (c, r). */
+    static constexpr uint64_t transpose(uint64_t b) {
+        for (int k = 1; k < N; ++k)
+            b = delta_swap(b, diagonal_mask(k), k * (N - 1) * W);
+        return b;
+    }
+
+    /**
+     * @brief Apply a symmetry to a bitboard.
+     * @param b The bitboard.
+     * @param transform The symmetry (0-7, see the class description).
+     */
+    static constexpr uint64_t transform(uint64_t b, int transform) {
+        switch (transform) {
+            case 1:  return mirror(transpose(b));
+            case 2:  return mirror(flip(b));
+            case 3:  return flip(transpose(b));
+            case 4:  return mirror(b);
+            case 5:  return flip(b);
+            case 6:  return transpose(b);
+            case 7:  return flip(mirror(transpose(b)));
+            default: return b;
+        }
+    }
+
+    /** @brief The symmetry that undoes a transform (the quarter turns undo each other). */
+    static constexpr int inverse(int transform) {
+        return (transform == 1 || transform == 3) ? 4 - transform : transform;
+    }
+
+    /**
+     * @brief Map a cell index through a symmetry.
+     * @param idx Cell index (N * row + col).
+     * @param transform The symmetry to apply.
+     * @param inverse Apply the inverse symmetry instead.
+     */
+    static constexpr int transform_cell(int idx, int transform, bool inverse = false) {
+        if (inverse) transform = Symmetry::inverse(transform);
+
+        int r = idx / N, c = idx % N;
+        switch (transform) {
+            case 1:  return N * c + (N - 1 - r);
+            case 2:  return N * (N - 1 - r) + (N - 1 - c);
+            case 3:  return N * (N - 1 - c) + r;
+            case 4:  return N * r + (N - 1 - c);
+            case 5:  return N * (N - 1 - r) + c;
+            case 6:  return N * c + r;
+            case 7:  return N * (N - 1 - c) + (N - 1 - r);
+            default: return idx;
+        }
+    }
+
+    /**
+     * @brief Smallest image of a bitboard over the 8 symmetries.
+     * @param b The bitboard.
+     * @param transform Receives the first symmetry producing it.
+     */
+    static uint64_t canonical(uint64_t b, int& transform) {
+        uint64_t best = b;
+        transform = 0;
+        for (int t = 1; t < 8; ++t) {
+            uint64_t image = Symmetry::transform(b, t);
+            if (image < best) {
+                best = image;
+                transform = t;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Canonical form of a position stored as two bitboards.
+     * @param first The first player's bits; replaced by its canonical image.
+     * @param second The second player's bits; replaced by its canonical image.
+     * @return The first symmetry producing the smallest (second, first) pair.
+     */
+    static int canonical_pair(uint64_t& first, uint64_t& second) {
+        uint64_t bestFirst = first, bestSecond = second;
+        int transform = 0;
+        for (int t = 1; t < 8; ++t) {
+            uint64_t s = Symmetry::transform(second, t);
+            if (s > bestSecond) continue;
+            uint64_t f = Symmetry::transform(first, t);
+            if (s < bestSecond || f < bestFirst) {
+                bestFirst = f;
+                bestSecond = s;
+                transform = t;
+            }
+        }
+        first = bestFirst;
+        second = bestSecond;
+        return transform;
+    }
+
+private:
+    /** @brief The W bits of one cell. */
+    static constexpr uint64_t cell_mask(int idx) {
+        return ((uint64_t(1) << W) - 1) << (W * idx);
+    }
+
+    /** @brief Bits of column j. */
+    static constexpr uint64_t column_mask(int j) {
+        uint64_t m = 0;
+        for (int r = 0; r < N; ++r) m |= cell_mask(N * r + j);
+        return m;
+    }
+
+    /** @brief Bits of row i. */
+    static constexpr uint64_t row_mask(int i) {
+        uint64_t m = 0;
+        for (int c = 0; c < N; ++c) m |= cell_mask(N * i + c);
+        return m;
+    }
+
+    /** @brief Bits of the cells k places right of the main diagonal. */
+    static constexpr uint64_t diagonal_mask(int k) {
+        uint64_t m = 0;
+        for (int r = 0; r + k < N; ++r) m |= cell_mask(N * r + r + k);
+        return m;
+    }
+};
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "BoardGame_Classes.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file Tablebase.h
+ * @brief Solved-game tables for small boards, built through the Board<T> rules.
+ */
+
+/**
+ * @class Tablebase
+ * @brief Exact value and best move of every position reachable from a start position.
+ *
+ * The build walks the game from the start position using nothing but the
+ * board's own rules: clone() to branch, update_board to play, and
+ * is_win / is_lose / is_draw (as GameManager calls them) to detect the end.
+ * Every position is solved once, children before parents, which is retrograde
+ * analysis for games that cannot repeat a position. Each position is then one
+ * fixed-size record in a sorted array, so a lookup is a binary search and the
+ * table can be saved to a file and loaded back unchanged.
+ *
+ * On square boards the encoder can fold the 8 symmetric images of a position
+ * into one record (see square_base3()); best moves are then stored in that
+ * record's orientation and mapped back onto the board by probe().
+ *
+ * Values are for the side to move: WIN - n for a win n plies from now,
+ * -(WIN - n) for a loss, 0 for a draw.
+ *
+ * @tparam T Type of symbol used on the board (trivially copyable).
+ */
+template <typename T>
+class Tablebase {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Tablebase records are written as raw bytes");
+
+    /**
+     * @brief Lists the candidate moves of the side to move.
+     * Moves that update_board then rejects are skipped, so a generator may be generous.
+     */
+    using MoveGenerator = std::function<void(Board<T>* board, T symbol, vector<Move<T>>& moves)>;
+
+    /**
+     * @brief Maps a board to a position code; different positions must get different codes.
+     * The side to move is added by the tablebase. An encoder that gives symmetric
+     * positions the same code sets transform to the symmetry taking the board to
+     * the orientation the code stands for (0 otherwise).
+     */
+    using Encoder = std::function<uint64_t(Board<T>* board, int& transform)>;
+
+    /**
+     * @brief Maps cell (x, y) through a symmetry reported by the encoder (or its inverse).
+     */
+    using CellMap = std::function<void(int& x, int& y, int transform, bool inverse)>;
+
+    static const int WIN = 1000;    ///< Base score of a win (minus the plies to reach it).
+
+    /**
+     * @brief One solved position.
+     */
+    struct Record {
+        uint64_t key;       ///< Position code * 2 + (second player to move).
+        int16_t value;      ///< Value for the side to move.
+        int8_t x, y;        ///< Best move (in the stored orientation), (-1, -1) at the end of the game.
+        T symbol;           ///< Symbol of the best move.
+    };
+
+    /**
+     * @brief Construct an empty tablebase for a two-player game.
+     * @param first Symbol of the player who moves first.
+     * @param second Symbol of the other player.
+     * @param generator Move generator for the game.
+     * @param encoder Position encoder for the game (see base3() and square_base3()).
+     * @param cells Cell mapping for an encoder that uses symmetry (see square_cells()).
+     */
+    Tablebase(T first, T second, MoveGenerator generator, Encoder encoder, CellMap cells = nullptr)
+        : symbols{first, second}, generator(std::move(generator)), encoder(std::move(encoder)),
+          cells(std::move(cells)), players{Player<T>("", first, PlayerType::COMPUTER), Player<T>("", second, PlayerType::COMPUTER)} {}
+
+    /**
+     * @brief An encoder reading every cell as a base-3 digit (blank, first, second).
+     * Suits boards of up to 40 cells; cells holding anything else read as blank.
+     */
+    static Encoder base3(T blank, T first, T second) {
+        return [blank, first, second](Board<T>* board, int& transform) {
+            transform = 0;
+            uint64_t code = 0;
+            for (int r = 0; r < board->get_rows(); ++r)
+                for (int c = 0; c < board->get_columns(); ++c) {
+                    T cell = board->get_cell(r, c);
+                    code = code * 3 + (cell == first ? 1 : cell == second ? 2 : 0);
+                }
+            return code;
+        };
+    }
+
+    /**
+     * @brief A base-3 encoder for an N x N board that gives all 8 symmetric images
+     *        of a position the same code. Use with square_cells<N>().
+     */
+    template <int N>
+    static Encoder square_base3(T blank, T first, T second) {
+        static_assert(N <= 6, "Base-3 codes of boards above 6x6 do not fit in 64 bits");
+        return [blank, first, second](Board<T>* board, int& transform) {
+            uint64_t own = 0, opp = 0;
+            for (int r = 0; r < N; ++r)
+                for (int c = 0; c < N; ++c) {
+                    T cell = board->get_cell(r, c);
+                    if (cell == first) own |= uint64_t(1) << (N * r + c);
+                    else if (cell == second) opp |= uint64_t(1) << (N * r + c);
+                }
+            transform = Symmetry<N>::canonical_pair(own, opp);
+
+            uint64_t code = 0;
+            for (int i = 0; i < N * N; ++i)
+                code = code * 3 + ((own >> i & 1) ? 1 : (opp >> i & 1) ? 2 : 0);
+            return code;
+        };
+    }
+
+    /** @brief The cell mapping matching square_base3<N>(). */
+    template <int N>
+    static CellMap square_cells() {
+        return [](int& x, int& y, int transform, bool inverse) {
+            int cell = Symmetry<N>::transform_cell(N * x + y, transform, inverse);
+            x = cell / N;
+            y = cell % N;
+        };
+    }
+
+    /**
+     * @brief Solve every position reachable from a start position.
+     * @param start The start position (left unchanged; it must implement clone()).
+     * @param toMove The symbol of the side to move.
+     * @return The number of positions in the table.
+     */
+    size_t build(Board<T>* start, T toMove) {
+        std::unique_ptr<Board<T>> root(start->clone());
+        if (!root) throw std::runtime_error("Error: Tablebase needs a board that implements clone().");
+
+        std::unordered_map<uint64_t, Record> solved;
+        solve(root.get(), toMove, solved);
+
+        records.clear();
+        records.reserve(solved.size());
+        for (auto& entry : solved) records.push_back(entry.second);
+        std::sort(records.begin(), records.end(),
+                  [](const Record& a, const Record& b) { return a.key < b.key; });
+        return records.size();
+    }
+
+    /**
+     * @brief Look a position up.
+     * @param board The position.
+     * @param toMove The symbol of the side to move.
+     * @param found Receives the position's record, its move mapped onto this board.
+     * @return false if the position is not in the table.
+     */
+    bool probe(Board<T>* board, T toMove, Record& found) const {
+        int transform;
+        uint64_t key = key_of(board, toMove, transform);
+        auto it = std::lower_bound(records.begin(), records.end(), key,
+                                   [](const Record& r, uint64_t k) { return r.key < k; });
+        if (it == records.end() || it->key != key) return false;
+
+        found = *it;
+        map_move(found, transform, true);
+        return true;
+    }
+
+    /** @brief Number of positions in the table. */
+    size_t size() const { return records.size(); }
+
+    /**
+     * @brief Write the sorted records to a file, as raw Record structs.
+     * @return false if the file could not be written.
+     */
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+        return bool(out);
+    }
+
+    /**
+     * @brief Replace the table with one written by save().
+     * @return false if the file is missing or malformed (the table is then left unchanged).
+     */
+    bool load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return false;
+        std::streamsize size = in.tellg();
+        if (size <= 0 || size % std::streamsize(sizeof(Record)) != 0) return false;
+
+        vector<Record> loaded(size_t(size) / sizeof(Record));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(loaded.data()), size)) return false;
+        records.swap(loaded);
+        return true;
+    }
+
+private:
+    /** @brief The opponent of a symbol. */
+    T other(T s) const { return s == symbols[0] ? symbols[1] : symbols[0]; }
+
+    /** @brief Table key of a position, and the symmetry to its stored orientation. */
+    uint64_t key_of(Board<T>* board, T toMove, int& transform) const {
+        return encoder(board, transform) * 2 + (toMove == symbols[0] ? 0 : 1);
+    }
+
+    /** @brief Map a record's move through a symmetry (nothing to do without one). */
+    void map_move(Record& rec, int transform, bool inverse) const {
+        if (!cells || transform == 0 || rec.x < 0) return;
+        int x = rec.x, y = rec.y;
+        cells(x, y, transform, inverse);
+        rec.x = int8_t(x);
+        rec.y = int8_t(y);
+    }
+
+    /**
+     * @brief Result of the move just made by mover: 1 if mover won, -1 if lost,
+     *        0 for a draw, 2 if the game goes on.
+     */
+    int outcome(Board<T>* b, T mover) {
+        Player<T>* p = &players[mover == symbols[0] ? 0 : 1];
+        p->set_board_ptr(b);
+        if (b->is_win(p)) return 1;
+        if (b->is_lose(p)) return -1;
+        if (b->is_draw(p)) return 0;
+        return 2;
+    }
+
+    /**
+     * @brief Solve a position and everything below it.
+     * @return The record of the position.
+     */
+    Record solve(Board<T>* board, T toMove, std::unordered_map<uint64_t, Record>& solved) {
+        int transform;
+        uint64_t key = key_of(board, toMove, transform);
+        auto it = solved.find(key);
+        if (it != solved.end()) return it->second;
+
+        Record rec{key, 0, -1, -1, T{}};
+        bool any = false;
+        vector<Move<T>> moves;
+        generator(board, toMove, moves);
+
+        for (auto& m : moves) {
+            std::unique_ptr<Board<T>> child(board->clone());
+            if (!child->update_board(&m)) continue;
+
+            // Score the move for the mover: a finished game, or the child's value negated
+            int value;
+            int result = outcome(child.get(), toMove);
+            if (result == 1) value = WIN - 1;
+            else if (result == -1) value = -(WIN - 1);
+            else if (result == 0) value = 0;
+            else {
+                int v = solve(child.get(), other(toMove), solved).value;
+                value = v > 0 ? -(v - 1) : v < 0 ? -(v + 1) : 0;   // One ply further away
+            }
+
+            if (!any || value > rec.value) {
+                any = true;
+                rec.value = int16_t(value);
+                rec.x = int8_t(m.get_x());
+                rec.y = int8_t(m.get_y());
+                rec.symbol = m.get_symbol();
+            }
+        }
+
+        map_move(rec, transform, false);    // Store the move in the key's orientation
+        solved.emplace(key, rec);
+        return rec;
+    }
+
+    T symbols[2];                   ///< The two players' symbols.
+    MoveGenerator generator;        ///< Candidate moves of a position.
+    Encoder encoder;                ///< Position codes.
+    CellMap cells;                  ///< Symmetry mapping for moves, empty if the encoder uses none.
+    Player<T> players[2];           ///< Players used to query the board's result functions.
+    vector<Record> records;         ///< Solved positions, sorted by key.
+};
@@ -13,6 +13,7 @@
 #include "BoardGame_Classes.h"
 #include "AI.h"
 #include "Custom_UI.h"
+#include "Tablebase.h"
 using namespace std;
 
 /**
@@ -69,7 +70,12 @@ public:
      * @return true if the game has ended, false otherwise.
      */
     bool game_is_over(Player<char>* player);
-   
+
+    /**
+     * @brief Creates a copy of the board (used by searches and the tablebase).
+     * @return A new X_O_Board with the same cells.
+     */
+    Board<char>* clone() const override;
 };
 
 
@@ -105,6 +111,12 @@ public:
      * @return A pointer to a new `Move<char>` object representing the player's action.
      */
     virtual Move<char>* get_move(Player<char>* player);
+
+    /**
+     * @brief The solved X-O table, built on first use (X moves first).
+     * @return The tablebase shared by all X-O UIs.
+     */
+    static const Tablebase<char>& tablebase();
 };
 
 #endif // XO_CLASSES_H